@@ -10,6 +10,7 @@
 #endif // _MSC_VER
 
 #include "files/file.hpp"
+#include "files/sink.hpp"
 //#include "files/load.hpp"
 
 #endif // !CONS_FILE_HEADER__
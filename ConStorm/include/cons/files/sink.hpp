@@ -0,0 +1,48 @@
+/*
+ Code by Drake Johnson
+
+ Defines the 'FileSink' class, which lets a cons::File be used as the
+ destination of printed output
+
+ Header includes:
+   - file.hpp        : File
+   - output/sink.hpp : OutputSink
+*/
+#ifndef CONS_FILE_SINK_HEADER__
+#define CONS_FILE_SINK_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include "file.hpp"
+#include "../output/sink.hpp"
+
+namespace cons
+{
+	/**
+	 Writes output to the output stream of a cons::File. The bytes are written
+	 as one block; nothing is formatted a second time. Combine with a TeeSink
+	 to mirror the console into a file. The file keeps a transcript: frames
+	 drawn by a Screen, such as menus, are written in full as plain lines.
+
+	 Nothing is written if the File's output stream is not open. The File
+	 must outlive this object.
+
+	 @param file_ The File to write to
+	*/
+	class FileSink final : public OutputSink
+	{
+	public:
+		explicit FileSink(File& file) noexcept : file_(file) {}
+
+		void write(const char* data, size_t size) override;
+		void flush() override;
+
+		[[nodiscard]] bool keeps_transcript() const override { return true; }
+
+		[[nodiscard]] File& get_file() const noexcept { return file_; }
+
+	private:
+		File& file_;
+	};
+} // namespace cons
+#endif // !CONS_FILE_SINK_HEADER__
@@ -88,9 +88,12 @@ namespace cons
                 prompt(invalid_msg);
             }
 
+            // Everything printed so far must be visible before blocking
+            flush_before_input();
             while (!(std::cin >> user_input))
             { // Validation loop for handling invalid input types
                 prompt(invalid_msg);
+                flush_before_input();
 
                 std::cin.clear();
                 std::cin.ignore(CIN_MAX, '\n');
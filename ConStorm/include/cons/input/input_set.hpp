@@ -65,9 +65,11 @@ namespace cons
                 else
                     prompt(invalid_msg);
 
+                flush_before_input();
                 while (!(std::cin >> user_input))
                 { // Handles invalid input types
                     prompt(invalid_msg);
+                    flush_before_input();
                     std::cin.clear();
                     std::cin.ignore(CIN_MAX, '\n');
                 }
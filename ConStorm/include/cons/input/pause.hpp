@@ -14,11 +14,22 @@
 #include "../output/print.hpp"
 namespace cons
 {
+	/**
+	 The message shown by 'pause()' when it is called without one
+	*/
+	constexpr const char* DEFAULT_PAUSE_MSG = "Press any key to continue...";
+
 	/**
 	 Pause the current thread and waits for user to press a key to continue
 
 	 @param msg The prompt to display to the user to continue past the pause
 	*/
-	void pause(const std::string& msg = "Press any key to continue...");
+	void pause(const std::string& msg = DEFAULT_PAUSE_MSG);
+
+	/**
+	 Identical to 'pause()', except nothing is printed. Pending output is
+	 still written first.
+	*/
+	void wait_for_key();
 } // namespace cons
 #endif // !CONS_PAUSE_HEADER__
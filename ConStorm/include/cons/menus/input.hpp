@@ -90,7 +90,7 @@ namespace cons
 	template <class ReturnTy>
 	InputMenu<ReturnTy, enable_if_cc_t<ReturnTy>>::InputMenu(Header title)
 		: title_(std::move(title))
-		, desc_("", 80U, 4U)
+		, desc_("", WordWrap::TERMINAL_WIDTH, 4U)
 		, validation_([](value_type dummy) -> bool { return true; })
 		, goto_next_(nullptr)
 	{}
@@ -98,7 +98,7 @@ namespace cons
 	template <class ReturnTy>
 	InputMenu<ReturnTy, enable_if_cc_t<ReturnTy>>::InputMenu(
 		std::function<bool(value_type)> validation_function)
-		: desc_("", 80U, 4U)
+		: desc_("", WordWrap::TERMINAL_WIDTH, 4U)
 		, validation_(std::move(validation_function))
 		, goto_next_(nullptr)
 	{}
@@ -107,7 +107,7 @@ namespace cons
 	InputMenu<ReturnTy, enable_if_cc_t<ReturnTy>>::InputMenu(Header title,
 		std::function<bool(value_type)> validation_function)
 		: title_(std::move(title))
-		, desc_("", 80U, 4U)
+		, desc_("", WordWrap::TERMINAL_WIDTH, 4U)
 		, validation_(std::move(validation_function))
 		, value_()
 		, goto_next_(nullptr)
@@ -116,7 +116,7 @@ namespace cons
 	template <class ReturnTy>
 	InputMenu<ReturnTy, enable_if_cc_t<ReturnTy>>::InputMenu(
 		const InputMenu& other)
-		: desc_("", 4U, 80U)
+		: desc_("", WordWrap::TERMINAL_WIDTH, 4U)
 	{
 		copy(*this, other);
 	}
@@ -124,7 +124,7 @@ namespace cons
 	template <class ReturnTy>
 	InputMenu<ReturnTy, enable_if_cc_t<ReturnTy>>::InputMenu(
 		InputMenu&& other) noexcept
-		: desc_("", 4U, 80U)
+		: desc_("", WordWrap::TERMINAL_WIDTH, 4U)
 	{
 		move(*this, std::move(other));
 	}
@@ -156,6 +156,9 @@ namespace cons
 		display();
 
 		value_ = input<value_type>(validation_);
+
+		// The input is echoed on the prompt's row
+		Screen::get().invalidate_after_input();
 		return goto_next_;
 	}
 
@@ -252,16 +255,18 @@ namespace cons
 	template <class ReturnTy>
 	void InputMenu<ReturnTy, enable_if_cc_t<ReturnTy>>::display() const
 	{
-		cls();
-		print(
-			title_,
-			desc_,
-			""
-		);
-		if (prompt_msg_.empty())
-			prompt();
-		else
-			prompt(prompt_msg_);
+		// Drawn into the screen, which writes only what changed since the
+		// last menu
+		auto& screen = Screen::get();
+		screen.begin_frame();
+
+		auto row = screen.draw(0, title_);
+		row = screen.draw(row, desc_) + 1;
+
+		const auto end = screen.write(0, row,
+			prompt_msg_.empty() ? DEFAULT_PROMPT : prompt_msg_);
+		screen.set_cursor(end, row);
+		screen.present();
 	}
 
 	template <class ReturnTy>
@@ -25,11 +25,16 @@
 	 - animate.hpp
 	 - clear_screen.hpp
 	 - header.hpp
+	 - layout.hpp
+
+   - <memory> : unique_ptr
 */
 #ifndef CONS_MENU_MENU_HEADER__
 #define CONS_MENU_MENU_HEADER__
 #include "interface.hpp"
 #include <cons/output/header.hpp>
+#include <cons/output/layout.hpp>
+#include <memory>
 
 namespace cons
 {
@@ -102,8 +107,6 @@ namespace cons
 		[[nodiscard]] WordWrap get_description() const;
 
 	protected:
-		Header title_;
-		WordWrap desc_;
 		std::string prompt_msg_;
 		options_container options_;
 		menu_container gotos_;
@@ -115,6 +118,25 @@ namespace cons
 
 		static void copy(Menu& dest, const Menu& src);
 		static void move(Menu& dest, Menu&& src) noexcept;
+
+	private:
+		// Private so that every change goes through a setter, which marks
+		// 'layout_' out of date
+		Header title_;
+		WordWrap desc_;
+
+		// Built by the first 'display()', so constructing a Menu never
+		// allocates one
+		mutable std::unique_ptr<Layout> layout_;
+		mutable bool layout_synced_ = false;
+
+		// The nodes of 'layout_', in the order they are added
+		static constexpr Layout::node_id TITLE_NODE = 1;
+		static constexpr Layout::node_id DESC_NODE = 2;
+		static constexpr Layout::node_id OPTIONS_NODE = 4;
+		static constexpr Layout::node_id PROMPT_NODE = 6;
+
+		static Layout make_layout();
 	};
 } // namespace cons
 #endif // !CONS_MENU_MENU_HEADER__
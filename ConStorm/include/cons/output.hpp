@@ -5,16 +5,17 @@
    - print.hpp
      - println.hpp
        - println/master.hpp
+         - buffer.hpp : OutputBuffer, OutputFrame, out()
          - <iostream> : cout
        - println/set.hpp
          - println/master.hpp
          - <set>           : set
          - <unordered_set> : unordered_set
+       - println/styled_text.hpp : StyledText
        - println/textf.hpp
          - println/master.hpp
          - <exception>   : exception
          - <string_view> : string_view
-         - <windows.h>   : CONSOLE_SCREEN_BUFFER_INFO, COORD, HANDLE, WORD
        - println/vector.hpp
          - println/master.hpp
          - <vector> : vector
@@ -23,6 +24,21 @@
          - <unordered_set> : unordered_set
          - <vector>        : vector
 
+   - flush.hpp : FlushPolicy, set_flush_policy()
+
+   - markup.hpp
+     - format.hpp  : CONS_FMT parsing
+     - console.hpp : ConsoleColor
+
+   - async_sink.hpp
+     - sink.hpp : OutputSink
+     - <thread> : thread
+
+   - format.hpp
+     - formatter.hpp : formatter, format_to()
+     - <array>       : array
+     - <tuple>       : tuple
+
    - prompt.hpp
      - println.hpp
      - <type_traits> : forward, move
@@ -31,11 +47,30 @@
      - println.hpp
      - <string> : string
 
+   - backend.hpp
+     - formatter.hpp : format_to()
+     - sink.hpp      : MemorySink, StdoutSink
+     - console.hpp   : ConsoleColor, TerminalInfo
+
    - clear_screen.hpp
      - print.hpp
      
    - header.hpp
      - textf.hpp : textf
+
+   - screen.hpp
+     - encoder.hpp   : UpdateEncoder
+     - header.hpp    : Header
+     - word_wrap.hpp : WordWrap
+
+   - render_thread.hpp
+     - screen.hpp : Screen, ScreenFrame
+
+   - log_pane.hpp
+     - screen.hpp : Screen
+
+   - layout.hpp
+     - screen.hpp : Screen, Header, WordWrap, StyledText
 */
 #ifdef _MSC_VER
 #	pragma once
@@ -45,8 +80,17 @@
 
 #include "output/println.hpp"
 #include "output/print.hpp"
+#include "output/flush.hpp"
+#include "output/format.hpp"
+#include "output/markup.hpp"
+#include "output/async_sink.hpp"
+#include "output/backend.hpp"
 #include "output/prompt.hpp"
 #include "output/clear_screen.hpp"
 #include "output/header.hpp"
+#include "output/screen.hpp"
+#include "output/render_thread.hpp"
+#include "output/log_pane.hpp"
+#include "output/layout.hpp"
 
 #endif // !CONS_OUTPUT_HEADER__
@@ -0,0 +1,182 @@
+/*
+ Code by Drake Johnson
+
+ Defines the 'AsyncSink' class, an OutputSink which hands its output to a
+ dedicated writer thread. Threads that print only copy their formatted bytes
+ into a lock-free ring buffer; the writer thread drains the ring and writes
+ everything it finds to another sink in one batch.
+
+ Header includes:
+   - sink.hpp               : OutputSink
+   - <atomic>               : atomic
+   - <condition_variable>   : condition_variable
+   - <cstdint>              : uint32_t, uint64_t
+   - <deque>                : deque
+   - <memory>               : unique_ptr
+   - <mutex>                : mutex
+   - <string>               : string
+   - <thread>               : thread
+*/
+#ifndef CONS_OUTPUT_ASYNC_SINK_HEADER__
+#define CONS_OUTPUT_ASYNC_SINK_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include "sink.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace cons
+{
+	/**
+	 What an AsyncSink does with a write that does not fit in its ring
+	*/
+	enum class AsyncOverflow
+	{
+		block, // Wait for the writer thread to free enough space
+		drop,  // Discard the write and count its bytes
+		spill  // Queue the write in a growable overflow list
+	};
+
+	/**
+	 Sends everything written to it to `target_` from a writer thread, so
+	 that printing never waits on a slow console. Writes are copied into a
+	 lock-free multi-producer ring: a producer claims space with a single
+	 compare-and-swap, copies its bytes, and publishes the write by storing its
+	 length. The writer thread collects every published write into one batch
+	 and passes the batch to `target_` in a single call.
+
+	 Each write is delivered whole and in order with respect to other writes
+	 from the same thread. Writes larger than the whole ring are always
+	 spilled, unless the policy is 'AsyncOverflow::drop'.
+
+	 Once the writer thread has stopped, during destruction, writes go
+	 straight to `target_` on the calling thread instead, one at a time. A
+	 writer blocked on a full ring at that point does the same.
+
+	 Call 'flush()' (or 'cons::flush_async()') before anything that depends on
+	 the output having reached the console, such as reading input.
+
+	 Example usage:
+	 @code
+		 cons::StdoutSink console;
+		 cons::AsyncSink async(console);
+		 cons::set_output_sink(&async);
+
+		 cons::print("Printed from the writer thread");
+		 cons::flush_async();
+		 const auto num = cons::input<int>();
+	 @endcode
+
+	 @param target_ The sink the writer thread writes to
+	 @param policy_ What to do with writes that do not fit in the ring
+	*/
+	class AsyncSink final : public OutputSink
+	{
+	public:
+		explicit AsyncSink(OutputSink& target, size_t capacity = 65536,
+			AsyncOverflow policy = AsyncOverflow::block);
+		AsyncSink(const AsyncSink&) = delete;
+		AsyncSink& operator=(const AsyncSink&) = delete;
+		~AsyncSink() override;
+
+		void write(const char* data, size_t size) override;
+
+		/**
+		 Blocks until every write made before this call has been passed to
+		 the target sink and the target sink has been flushed
+		*/
+		void flush() override;
+
+		/**
+		 @returns The number of bytes the ring can hold
+		*/
+		[[nodiscard]] size_t get_capacity() const noexcept;
+		[[nodiscard]] AsyncOverflow get_policy() const noexcept { return policy_; }
+
+		/**
+		 @returns The number of bytes discarded by the 'drop' policy
+		*/
+		[[nodiscard]] size_t get_dropped() const noexcept { return dropped_.load(); }
+
+		/**
+		 @returns The number of writes sent to the overflow list
+		*/
+		[[nodiscard]] size_t get_spilled() const noexcept { return spilled_.load(); }
+
+	private:
+		static constexpr size_t CACHE_LINE = 64;
+		static constexpr size_t CELL_DATA = CACHE_LINE - sizeof(std::uint32_t);
+
+		/**
+		 One slot of the ring. A write takes as many consecutive cells as it
+		 needs; the length of the write is stored in the first one, and is zero
+		 while the write is unpublished.
+		*/
+		struct alignas(CACHE_LINE) cell
+		{
+			std::atomic<std::uint32_t> size{ 0 };
+			char data[CELL_DATA];
+		};
+
+		/**
+		 A write that did not fit in the ring. `pos` is the ring position it
+		 must be delivered before.
+		*/
+		struct spilled_write
+		{
+			std::uint64_t pos;
+			std::string data;
+		};
+
+		OutputSink& target_;
+		AsyncOverflow policy_;
+		size_t cell_count_;
+		std::unique_ptr<cell[]> cells_;
+
+		alignas(CACHE_LINE) std::atomic<std::uint64_t> head_{ 0 };
+		alignas(CACHE_LINE) std::atomic<std::uint64_t> tail_{ 0 };
+		alignas(CACHE_LINE) std::atomic<std::uint64_t> delivered_{ 0 };
+		std::atomic<std::uint64_t> spill_count_{ 0 };
+		std::atomic<std::uint64_t> spill_delivered_{ 0 };
+		std::atomic<bool> spilling_{ false };
+		std::atomic<bool> sleeping_{ false };
+		std::atomic<unsigned> waiters_{ 0 };
+		std::atomic<size_t> dropped_{ 0 };
+		std::atomic<size_t> spilled_{ 0 };
+		bool stop_ = false;
+		std::atomic<bool> finished_{ false }; // The writer thread has stopped
+
+		std::mutex mutex_;
+		std::condition_variable work_cv_;
+		std::condition_variable progress_cv_;
+
+		mutable std::mutex spill_mutex_;
+		std::deque<spilled_write> spill_;
+
+		std::thread writer_;
+
+		bool try_claim(size_t count, std::uint64_t& pos);
+		void publish(std::uint64_t pos, const char* data, size_t size);
+		void spill(const char* data, size_t size);
+		void wake_writer();
+
+		/**
+		 Writes to `target_` on the calling thread. Only used once the
+		 writer thread has stopped. Called with `mutex_` held.
+		*/
+		void write_through(const char* data, size_t size);
+
+		void run();
+		size_t drain(std::string& batch, std::uint64_t& tail);
+		size_t drain_spill(std::string& batch, std::uint64_t tail);
+		bool has_work(std::uint64_t tail) const;
+	};
+} // namespace cons
+#endif // !CONS_OUTPUT_ASYNC_SINK_HEADER__
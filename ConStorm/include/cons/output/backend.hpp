@@ -0,0 +1,349 @@
+/*
+ Code by Drake Johnson
+
+ Defines the console backends: the only code which knows how a screen is
+ cleared, how the cursor is moved, how colors are set, and how the
+ terminal's size is read. One backend is chosen at compile time as
+ 'cons::console_backend'; every operation is a static function, so calls
+ are resolved (and the ANSI ones inlined) without virtual dispatch.
+
+   - backend::ansi    : escape sequences written with the rest of the
+                        output (the default outside of Windows)
+   - backend::windows : the Windows console API (the default on Windows)
+   - backend::memory  : escape sequences written to an in-memory sink,
+                        with a fixed size and no terminal queries, so the
+                        whole library runs headless. Selected by defining
+                        CONS_BACKEND_MEMORY.
+
+ Header includes:
+   - formatter.hpp                  : format_to, OutputBuffer
+   - sink.hpp                       : MemorySink, StdoutSink
+   - utilities/console/color.hpp    : ConsoleColor
+   - utilities/console/terminal.hpp : TerminalInfo
+   - <atomic>                       : atomic
+   - <string_view>                  : string_view
+*/
+#ifndef CONS_OUTPUT_BACKEND_HEADER__
+#define CONS_OUTPUT_BACKEND_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include "formatter.hpp"
+#include "sink.hpp"
+#include "../utilities/console/color.hpp"
+#include "../utilities/console/terminal.hpp"
+#include <atomic>
+#include <string_view>
+
+namespace cons
+{
+	namespace backend
+	{
+		struct terminal_size
+		{
+			unsigned columns;
+			unsigned rows;
+		};
+
+		/**
+		 Called when the terminal is resized. Must be async-signal-safe.
+		*/
+		using resize_callback = void (*)() noexcept;
+
+		/**
+		 Writes ANSI escape sequences into the output buffer, so they reach
+		 the terminal in the same write as the text around them
+		*/
+		class ansi
+		{
+		public:
+			/**
+			 Whether styles are written inline with the text. When false,
+			 they are applied when set, and the text before them is flushed.
+			*/
+			static constexpr bool INLINE_STYLES = true;
+
+			/**
+			 Whether the real terminal is described by the environment
+			 ($TERM, $NO_COLOR, $COLORTERM) and its terminfo entry
+			*/
+			static constexpr bool HOST_TERMINAL = true;
+
+			[[nodiscard]] static bool is_output_terminal() noexcept;
+			[[nodiscard]] static bool is_input_terminal() noexcept;
+
+			/**
+			 @returns Whether the size could be read into `size`
+			*/
+			[[nodiscard]] static bool query_size(terminal_size& size) noexcept;
+
+			/**
+			 Arranges for `callback` to be called on every resize (SIGWINCH)
+			*/
+			static void on_resize(resize_callback callback) noexcept;
+
+			[[nodiscard]] static OutputSink& get_sink()
+			{
+				static StdoutSink s_sink;
+				return s_sink;
+			}
+
+			/**
+			 @returns The colors of text which has no style set
+			*/
+			[[nodiscard]] static ConsoleColor get_default_color() noexcept
+			{
+				return ConsoleColor();
+			}
+
+			/**
+			 Clears the screen and moves the cursor to the top left
+			*/
+			static void clear(OutputBuffer& buf)
+			{
+				if (TerminalInfo::get().is_styled())
+					buf.append(get_clear_sequence());
+			}
+
+			/**
+			 Clears from the cursor to the end of the screen
+			*/
+			static void clear_below(OutputBuffer& buf)
+			{
+				if (TerminalInfo::get().is_styled())
+					buf.append("\x1b[J");
+			}
+
+			/**
+			 Moves the cursor to the zero-based column `x` and row `y`
+			*/
+			static void move_cursor(OutputBuffer& buf, const unsigned x, const unsigned y)
+			{
+				if (!TerminalInfo::get().is_styled())
+					return;
+
+				buf.append("\x1b[");
+				format_to(buf, y + 1);
+				buf.append(';');
+				format_to(buf, x + 1);
+				buf.append('H');
+			}
+
+			/**
+			 Moves the cursor `dx` columns right (left if negative) and `dy`
+			 rows down (up if negative). Moving down past the bottom row
+			 scrolls the screen.
+			*/
+			static void move_cursor_by(OutputBuffer& buf, const int dx, const int dy)
+			{
+				if (!TerminalInfo::get().is_styled())
+					return;
+
+				if (dx != 0)
+					append_csi(buf, dx > 0 ? static_cast<unsigned>(dx) : static_cast<unsigned>(-dx),
+						dx > 0 ? 'C' : 'D');
+				if (dy < 0)
+					append_csi(buf, static_cast<unsigned>(-dy), 'A');
+				for (int i = 0; i < dy; ++i)
+					buf.append("\x1b" "D"); // Index, which scrolls at the bottom
+			}
+
+			/**
+			 Remembers the cursor's position, to be returned to by
+			 'restore_cursor()'
+			*/
+			static void save_cursor(OutputBuffer& buf)
+			{
+				if (TerminalInfo::get().is_styled())
+					buf.append("\x1b" "7");
+			}
+
+			static void restore_cursor(OutputBuffer& buf)
+			{
+				if (TerminalInfo::get().is_styled())
+					buf.append("\x1b" "8");
+			}
+
+			/**
+			 Scrolls the zero-based rows `top` to `bottom` (inclusive) up one
+			 row, leaving the bottom one blank. No other row changes. The
+			 cursor is left anywhere; see 'save_cursor()'.
+			*/
+			static void scroll_up(OutputBuffer& buf, const unsigned top, const unsigned bottom)
+			{
+				if (!TerminalInfo::get().is_styled())
+					return;
+
+				// The scroll region (DECSTBM) is set only for the scroll, so
+				// that nothing else written can scroll it
+				buf.append("\x1b[");
+				format_to(buf, top + 1);
+				buf.append(';');
+				format_to(buf, bottom + 1);
+				buf.append('r');
+				move_cursor(buf, 0, bottom);
+				buf.append("\x1b" "D" "\x1b[r");
+			}
+
+			/**
+			 Sets the colors of the text appended after this call. The
+			 buffer skips the sequence when the colors are already set.
+			*/
+			static void set_style(OutputBuffer& buf, const ConsoleColor color)
+			{
+				buf.set_attributes(ConsoleColor::get_attribute_id(color),
+					ConsoleColor::get_ansi_sequence(color).view());
+			}
+
+			/**
+			 Returns to the default colors. The reset is held back until
+			 something uncolored follows (see 'OutputBuffer').
+			*/
+			static void reset_style(OutputBuffer& buf) { buf.release_attributes(); }
+
+			/**
+			 Sets the colors of everything printed from now on, until
+			 'restore_default_style()'. Unlike 'set_style()', the colors
+			 outlive the buffer.
+			*/
+			static void set_default_style(OutputBuffer& buf, const ConsoleColor color)
+			{
+				if (TerminalInfo::get().is_styled())
+					buf.append(ConsoleColor::get_ansi_sequence(color).view());
+			}
+
+			static void restore_default_style(OutputBuffer& buf)
+			{
+				if (TerminalInfo::get().is_styled())
+					buf.append(ANSI_RESET);
+			}
+
+		private:
+			/**
+			 @returns The terminal's clear sequence from terminfo, read once
+			*/
+			[[nodiscard]] static std::string_view get_clear_sequence();
+
+			static void append_csi(OutputBuffer& buf, const unsigned count, const char command)
+			{
+				buf.append("\x1b[");
+				if (count != 1)
+					format_to(buf, count);
+				buf.append(command);
+			}
+		};
+
+		/**
+		 Writes ANSI escape sequences to an in-memory sink. The terminal is
+		 always styled, displays 24-bit color, has the built-in ANSI
+		 capabilities rather than a terminfo entry, and is the size set by
+		 'set_size()' (80x24 by default). Nothing is read from the real
+		 terminal or the environment, so the output is the same everywhere.
+		*/
+		class memory : public ansi
+		{
+		public:
+			static constexpr bool HOST_TERMINAL = false;
+
+			[[nodiscard]] static bool is_output_terminal() noexcept { return true; }
+			[[nodiscard]] static bool is_input_terminal() noexcept { return false; }
+
+			[[nodiscard]] static bool query_size(terminal_size& size) noexcept
+			{
+				size = { s_columns.load(), s_rows.load() };
+				return true;
+			}
+
+			static void on_resize(const resize_callback callback) noexcept
+			{
+				s_on_resize.store(callback);
+			}
+
+			[[nodiscard]] static OutputSink& get_sink() { return get_memory_sink(); }
+
+			/**
+			 @returns The sink everything printed is written to
+			*/
+			[[nodiscard]] static MemorySink& get_memory_sink()
+			{
+				static MemorySink s_sink;
+				return s_sink;
+			}
+
+			/**
+			 Resizes the simulated terminal, as a resize event would
+			*/
+			static void set_size(const terminal_size size) noexcept
+			{
+				s_columns.store(size.columns);
+				s_rows.store(size.rows);
+				if (const auto callback = s_on_resize.load())
+					callback();
+			}
+
+		private:
+			static inline std::atomic<unsigned> s_columns{ TerminalInfo::DEFAULT_COLUMNS };
+			static inline std::atomic<unsigned> s_rows{ TerminalInfo::DEFAULT_ROWS };
+			static inline std::atomic<resize_callback> s_on_resize{ nullptr };
+		};
+
+#ifdef _WIN32
+		/**
+		 Applies everything through the Windows console API. Console
+		 attributes and cursor moves apply at write time, so each operation
+		 first flushes the text before it. Styles only apply to output
+		 headed for the console (the thread's own OutputBuffer).
+		*/
+		class windows
+		{
+		public:
+			static constexpr bool INLINE_STYLES = false;
+			static constexpr bool HOST_TERMINAL = true;
+
+			[[nodiscard]] static bool is_output_terminal() noexcept;
+			[[nodiscard]] static bool is_input_terminal() noexcept;
+			[[nodiscard]] static bool query_size(terminal_size& size) noexcept;
+
+			/**
+			 The console has no resize signal; 'TerminalInfo::invalidate()'
+			 must be called after a resize event is read
+			*/
+			static void on_resize(resize_callback) noexcept {}
+
+			[[nodiscard]] static OutputSink& get_sink()
+			{
+				static StdoutSink s_sink;
+				return s_sink;
+			}
+
+			/**
+			 @returns The colors 'reset_style()' returns to: the console's
+			          colors when the program first asked, or the ones set by
+			          'set_default_style()'
+			*/
+			[[nodiscard]] static ConsoleColor get_default_color() noexcept;
+
+			static void clear(OutputBuffer& buf);
+			static void clear_below(OutputBuffer& buf);
+			static void move_cursor(OutputBuffer& buf, unsigned x, unsigned y);
+			static void move_cursor_by(OutputBuffer& buf, int dx, int dy);
+			static void save_cursor(OutputBuffer& buf);
+			static void restore_cursor(OutputBuffer& buf);
+			static void scroll_up(OutputBuffer& buf, unsigned top, unsigned bottom);
+			static void set_style(OutputBuffer& buf, ConsoleColor color);
+			static void reset_style(OutputBuffer& buf);
+			static void set_default_style(OutputBuffer& buf, ConsoleColor color);
+			static void restore_default_style(OutputBuffer& buf);
+		};
+#endif // _WIN32
+	} // namespace backend
+
+#if defined(CONS_BACKEND_MEMORY)
+	using console_backend = backend::memory;
+#elif defined(_WIN32)
+	using console_backend = backend::windows;
+#else
+	using console_backend = backend::ansi;
+#endif // CONS_BACKEND_MEMORY
+} // namespace cons
+#endif // !CONS_OUTPUT_BACKEND_HEADER__
@@ -0,0 +1,373 @@
+/*
+ Code by Drake Johnson
+
+ Defines the 'OutputBuffer' class and the 'OutputFrame' class. Together,
+ these gather everything a single call to cons::print() or cons::prompt()
+ displays into one contiguous block of memory, which is then handed to an
+ OutputSink in a single write.
+
+ Header includes:
+   - flush.hpp     : FlushPolicy
+   - sink.hpp      : OutputSink
+   - <cstddef>     : size_t
+   - <cstdint>     : uint64_t
+   - <ostream>     : ostream
+   - <streambuf>   : streambuf
+   - <string>      : string
+   - <string_view> : string_view
+   - <vector>      : vector
+*/
+#ifndef CONS_OUTPUT_BUFFER_HEADER__
+#define CONS_OUTPUT_BUFFER_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include "flush.hpp"
+#include "sink.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cons
+{
+	/**
+	 A growable, contiguous character buffer. Clearing the buffer keeps its
+	 capacity, so a long-lived buffer stops allocating once it has grown to
+	 the size of the largest output it has held.
+
+	 Types without a faster path can be written through 'stream()', which is an
+	 std::ostream that appends into this buffer instead of std::cout.
+
+	 The buffer also tracks the text attributes (colors) its escape sequences
+	 leave the terminal in, so that a sequence is only appended when it
+	 changes them. Releasing attributes does not append the reset right away:
+	 it is appended before the next characters written in the default
+	 attributes, or once when the buffer is flushed. Objects printed back to
+	 back in the same colors therefore share one pair of sequences. When
+	 'TerminalInfo::is_styled()' is false, no attributes are set at all.
+
+	 A frame a Screen presents for a sink which keeps a transcript (see
+	 'OutputSink::keeps_transcript()') is buffered twice: as the update for
+	 the terminal, followed by the whole frame as plain lines. The buffer
+	 remembers where each copy is, and each sink is written only its own.
+
+	 @param data_          The buffered characters
+	 @param attributes_    The attributes in effect at the end of 'data_'; zero
+	                       for the terminal's defaults
+	 @param reset_pending_ Whether 'attributes_' were released but not reset
+	 @param frames_        Where each frame with a transcript is in 'data_'
+	 @param streambuf_     Adapts the buffer to the std::streambuf interface
+	 @param stream_        An std::ostream which writes into 'streambuf_'
+	*/
+	class OutputBuffer
+	{
+	public:
+		OutputBuffer();
+		OutputBuffer(const OutputBuffer&) = delete;
+		OutputBuffer& operator=(const OutputBuffer&) = delete;
+		~OutputBuffer() = default;
+
+		void append(const char* data, size_t size) { commit_reset(); data_.append(data, size); }
+		void append(std::string_view str) { commit_reset(); data_.append(str.data(), str.size()); }
+		void append(const char ch) { commit_reset(); data_.push_back(ch); }
+		void append(const size_t count, const char ch) { commit_reset(); data_.append(count, ch); }
+		void insert(const size_t pos, const size_t count, const char ch) { data_.insert(pos, count, ch); }
+
+		/**
+		 A frame buffered for both the terminal and a transcript. The
+		 terminal's update is 'begin' to 'split'; the plain lines are
+		 'split' to 'end'.
+		*/
+		struct transcript_frame
+		{
+			size_t begin;
+			size_t split;
+			size_t end;
+		};
+
+		/**
+		 Output set aside by 'hold()'
+		*/
+		struct held_output
+		{
+			std::string data;
+			std::uint64_t attributes = 0;
+			bool reset_pending = false;
+			std::vector<transcript_frame> frames;
+		};
+
+		/**
+		 Moves the buffered characters and the attributes they leave in
+		 effect into `held`, leaving the buffer empty in the default
+		 attributes. The buffer keeps its capacity.
+		*/
+		void hold(held_output& held);
+
+		/**
+		 Puts output set aside by 'hold()' back into the empty buffer
+		*/
+		void restore(held_output& held);
+
+		/**
+		 Appends `sequence` unless the attributes it sets are already in
+		 effect. A pending reset is dropped, since `sequence` replaces every
+		 attribute the reset would have cleared.
+
+		 @param attributes A nonzero value which identifies the attributes
+		                   `sequence` sets
+		 @param sequence   The escape sequence which sets them
+		*/
+		void set_attributes(std::uint64_t attributes, std::string_view sequence);
+
+		/**
+		 Marks the current attributes as no longer needed. The reset is
+		 appended lazily (see above).
+		*/
+		void release_attributes() noexcept { reset_pending_ = attributes_ != 0; }
+
+		/**
+		 Appends the reset sequence now if any attributes are in effect. Called
+		 before the buffer is written to its sink.
+		*/
+		void reset_attributes();
+
+		/**
+		 Appends a released reset now rather than with the next characters,
+		 so that what is appended next starts after it
+		*/
+		void commit_reset()
+		{
+			if (reset_pending_)
+				reset_attributes();
+		}
+
+		/**
+		 @returns The attributes in effect at the end of the buffer, or zero
+		          for the terminal's defaults
+		*/
+		[[nodiscard]] std::uint64_t get_attributes() const noexcept { return attributes_; }
+
+		/**
+		 @returns An std::ostream which appends everything inserted into it to
+		          this buffer
+		*/
+		[[nodiscard]] std::ostream& stream() { return stream_; }
+
+		/**
+		 Marks the characters from `begin` to `split` as a Screen's update of
+		 the terminal, and those from `split` to the end of the buffer as the
+		 same frame written as plain lines
+		*/
+		void add_transcript_frame(size_t begin, size_t split);
+
+		/**
+		 @returns Whether the buffer holds any frame added by
+		          'add_transcript_frame()'
+		*/
+		[[nodiscard]] bool has_transcript() const noexcept { return !frames_.empty(); }
+
+		/**
+		 Copies the buffer into what a terminal is written, `terminal`, and
+		 what a transcript is written, `transcript`
+		*/
+		void split_transcript(std::string& terminal, std::string& transcript) const;
+
+		/**
+		 @returns The number of characters a terminal is written, which
+		          leaves out the plain lines of every transcript frame
+		*/
+		[[nodiscard]] size_t get_terminal_size() const noexcept;
+
+		[[nodiscard]] const char* data() const noexcept { return data_.data(); }
+		[[nodiscard]] size_t size() const noexcept { return data_.size(); }
+		[[nodiscard]] bool empty() const noexcept { return data_.empty(); }
+
+		/**
+		 Removes all characters from the buffer without releasing its memory
+		*/
+		void clear() noexcept
+		{
+			data_.clear();
+			frames_.clear();
+		}
+
+	private:
+		class streambuf : public std::streambuf
+		{
+		public:
+			explicit streambuf(OutputBuffer& buf) : buf_(buf) {}
+
+		protected:
+			int_type overflow(int_type ch) override;
+			std::streamsize xsputn(const char* str, std::streamsize count) override;
+
+		private:
+			OutputBuffer& buf_;
+		};
+
+		std::string data_;
+		std::uint64_t attributes_ = 0;
+		bool reset_pending_ = false;
+		std::vector<transcript_frame> frames_;
+		streambuf streambuf_;
+		std::ostream stream_;
+	};
+
+	/**
+	 Opens a frame of buffered output on the calling thread. Everything printed
+	 while a frame is open is gathered in that thread's OutputBuffer. When the
+	 outermost frame closes, the buffer is handed to the frame's OutputSink
+	 with one call. Frames may be nested freely; inner frames cost only a
+	 counter increment. The FlushPolicy can make frames write more often
+	 ('immediate') or hold their output longer ('on_input', 'manual').
+
+	 A frame constructed with a sink sends its output, and the output of every
+	 frame nested inside it, to that sink instead of the one returned by
+	 'get_output_sink()'. Output still pending for the previous sink is set
+	 aside while the frame is open and put back when it closes, so it is
+	 written when the FlushPolicy says, not early.
+
+	 Example usage:
+	 @code
+	 { // One write for the whole block
+		 cons::OutputFrame frame;
+		 cons::print("Line 1", "Line 2");
+		 cons::prompt();
+	 }
+
+	 cons::MemorySink mem;
+	 { // Rendered into memory instead of the console
+		 cons::OutputFrame frame(mem);
+		 cons::print("Line 1", "Line 2");
+	 }
+	 @endcode
+
+	 @param prev_sink_  The calling thread's sink before this frame was opened
+	 @param prev_depth_ The calling thread's frame depth before this frame
+	 @param redirect_   Whether this frame was constructed with its own sink
+	 @param held_       The output pending for 'prev_sink_', if `redirect_`
+	*/
+	class OutputFrame
+	{
+	public:
+		OutputFrame() noexcept;
+		explicit OutputFrame(OutputSink& sink);
+		OutputFrame(const OutputFrame&) = delete;
+		OutputFrame& operator=(const OutputFrame&) = delete;
+		~OutputFrame();
+
+		/**
+		 @returns The calling thread's OutputBuffer
+		*/
+		[[nodiscard]] static OutputBuffer& buffer();
+
+		/**
+		 @returns The sink the calling thread's output is currently sent to
+		*/
+		[[nodiscard]] static OutputSink& sink();
+
+		/**
+		 Writes everything in the calling thread's OutputBuffer to its sink
+		 immediately, whether or not a frame is open
+		*/
+		static void flush();
+
+	private:
+		OutputSink* prev_sink_;
+		unsigned prev_depth_;
+		bool redirect_;
+		OutputBuffer::held_output held_;
+
+		static unsigned& depth() noexcept;
+		static OutputSink*& thread_sink() noexcept;
+	};
+
+	/**
+	 @returns The OutputBuffer that 'println' specializations write into: the
+	          calling thread's own, or the buffer a 'formatter' is filling
+	          while it runs a 'println' specialization
+	*/
+	[[nodiscard]] OutputBuffer& out();
+
+	/**
+	 Writes the calling thread's pending output to its sink, then waits until
+	 the sink has delivered everything written to it. With an AsyncSink, this
+	 waits for the writer thread; with other sinks, it only flushes. While a
+	 RenderThread is running, it also waits for the newest frame to be
+	 painted. Called before blocking on user input so that prompts are never
+	 shown late.
+	*/
+	void flush_async();
+
+	/**
+	 Turns atomic-line mode on or off for the whole program. In atomic-line
+	 mode, each flushed OutputFrame is written to its sink while holding a
+	 lock, so the output of one 'print()' call from one thread is never torn
+	 by output from another. Formatting still happens in each thread's own
+	 OutputBuffer without the lock; only the single write to the sink is
+	 serialized.
+
+	 Not needed with an AsyncSink, whose writes are already atomic.
+
+	 @param enabled Whether atomic-line mode is on (off by default)
+	*/
+	void set_atomic_lines(bool enabled) noexcept;
+
+	/**
+	 @returns Whether atomic-line mode is on
+	*/
+	[[nodiscard]] bool get_atomic_lines() noexcept;
+
+	/**
+	 @returns The number of times the library has changed the console's text
+	          attributes (by escape sequence or console API call) since the
+	          program started
+	*/
+	[[nodiscard]] size_t get_attribute_transitions() noexcept;
+
+	/**
+	 @returns The number of bytes the library has written to the output sink
+	          (see 'set_output_sink()') since the program started, apart from
+	          UncountedOutput. Output an OutputFrame sends to another sink is
+	          not counted.
+	*/
+	[[nodiscard]] size_t get_bytes_written() noexcept;
+
+	/**
+	 Leaves out of 'get_bytes_written()' what the calling thread writes to
+	 its sink while this exists, so that a Screen does not repaint over it.
+	 Only for output which returns the cursor to where it was and changes
+	 no row a Screen draws on, such as a LogPane's. The thread's pending
+	 output is written before and after, so that only the output in
+	 between is left out.
+	*/
+	class UncountedOutput
+	{
+	public:
+		UncountedOutput();
+		UncountedOutput(const UncountedOutput&) = delete;
+		UncountedOutput& operator=(const UncountedOutput&) = delete;
+		~UncountedOutput();
+	};
+
+	namespace detail
+	{
+		/**
+		 Counts one change of the console's text attributes
+		*/
+		void count_attribute_transition() noexcept;
+
+		/**
+		 Makes 'out()' return `target` on the calling thread, or the
+		 thread's own buffer for nullptr
+
+		 @returns The previous target
+		*/
+		OutputBuffer* set_output_target(OutputBuffer* target) noexcept;
+	} // namespace detail
+} // namespace cons
+#endif // !CONS_OUTPUT_BUFFER_HEADER__
@@ -6,13 +6,11 @@
  Windows and Unix based systems.
 
  Header includes:
-   - print.hpp : print()
-     - println.hpp
-     - <type_traits>
-    
-   - <windows.h> : HANDLE, CONSOLE_SCREEN_BUFFER_INFO, DWORD, COORD
-   - <unistd.h>
-   - <term.h>
+   - <exception> : exception
+
+ The screen is cleared by the console backend (see backend.hpp). With
+ ANSI, that is the sequence from the terminal's terminfo entry, which is
+ read once; terminals without an entry are cleared with the ANSI sequence.
 */
 #ifndef CONS_CLEAR_SCREEN_HEADER__
 #define CONS_CLEAR_SCREEN_HEADER__
@@ -25,7 +23,7 @@ namespace cons
     // Exception for any errors during screen clearing
     struct ClearScreenException : std::exception
     {
-        [[nodiscard]] const char* what() const override
+        [[nodiscard]] const char* what() const noexcept override
         {
             return "\nERROR CLEARING SCREEN!";
         }
@@ -0,0 +1,211 @@
+/*
+ Code by Drake Johnson
+
+ Contains the UpdateEncoder class, which writes the cursor movement and
+ repeated characters of a screen update in as few bytes as the terminal
+ allows
+
+ Header includes:
+   - buffer.hpp                     : OutputBuffer
+   - utilities/console/terminfo.hpp : Terminfo
+   - <atomic>                       : atomic
+   - <cstdint>                      : uint32_t
+   - <string>                       : string
+   - <vector>                       : vector
+*/
+#ifndef CONS_OUTPUT_ENCODER_HEADER__
+#define CONS_OUTPUT_ENCODER_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include "buffer.hpp"
+#include "../utilities/console/terminfo.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cons
+{
+	/**
+	 One character cell of a Screen
+	*/
+	struct screen_cell
+	{
+		std::uint32_t glyph; // The UTF-8 bytes, first byte lowest; 0 if unknown
+		std::uint32_t style; // An index into the screen's styles; 0 is the default
+
+		bool operator==(const screen_cell other) const noexcept
+		{
+			return glyph == other.glyph && style == other.style;
+		}
+
+		bool operator!=(const screen_cell other) const noexcept { return !(*this == other); }
+	};
+
+	/**
+	 Picks the cheapest way to move the cursor and to write runs of cells,
+	 by the byte costs of the terminal's own capabilities. The cost of each
+	 capability is measured once, for every parameter up to TABLE_SIZE, by
+	 expanding it; moves are then priced by table lookups.
+
+	 A move is the cheapest of:
+	   - an absolute move (cursor_address)
+	   - a vertical move (parm_up/down_cursor, cursor_up/down, or
+	     row_address), then a horizontal one
+	   - a carriage return, then the vertical and horizontal moves
+	   - a carriage return and line feed per row down, then a horizontal move
+	 where a horizontal move is parm_left/right_cursor, cursor_left/right,
+	 column_address, or rewriting the characters already on the screen.
+
+	 Runs of one character use repeat_char, and a row which ends in blanks
+	 uses clr_eol, when they are shorter than the characters themselves.
+	 repeat_char is only used after 'set_repeat_enabled(true)': many
+	 terminals use xterm's entry, which lists it, without implementing it,
+	 and would show one character where a run was meant.
+
+	 Without a terminfo entry, the capabilities every ANSI terminal has are
+	 assumed. Line feeds are always preceded by a carriage return, so moves
+	 are correct whether or not the terminal translates line feeds.
+
+	 @param caps_   The parameterized capabilities, by 'param_cap'
+	 @param costs_  The length of each parameterized capability, by
+	                parameter, for parameters below TABLE_SIZE
+	 @param cr_     The fixed capabilities: carriage return, one column
+	                left and right, one row up and down, and erase line
+	*/
+	class UpdateEncoder
+	{
+	public:
+		/**
+		 A cursor position. Either coordinate may be UNKNOWN.
+		*/
+		struct position
+		{
+			unsigned x;
+			unsigned y;
+		};
+
+		static constexpr unsigned UNKNOWN = ~0U;
+
+		/**
+		 The cost of a capability the terminal lacks
+		*/
+		static constexpr unsigned UNAVAILABLE = 1U << 20;
+
+		/**
+		 The parameters which have their costs stored in the tables
+		*/
+		static constexpr unsigned TABLE_SIZE = 256;
+
+		explicit UpdateEncoder(const Terminfo& terminfo);
+
+		/**
+		 @returns The encoder for the terminal's terminfo entry
+		*/
+		[[nodiscard]] static const UpdateEncoder& get();
+
+		/**
+		 @param from  Where the cursor is; an UNKNOWN coordinate allows only
+		              an absolute move
+		 @param to    Where the cursor should be
+		 @param row   The cells shown on row `to.y`, which may be rewritten
+		              to move right over them. May be null.
+		 @param style The style in effect; only known cells in it are rewritten
+		 @returns The number of bytes 'move()' would write
+		*/
+		[[nodiscard]] unsigned get_move_cost(position from, position to,
+			const screen_cell* row, std::uint32_t style) const;
+
+		/**
+		 Writes the cheapest sequence which moves the cursor from `from` to
+		 `to` (see 'get_move_cost()')
+		*/
+		void move(OutputBuffer& buf, position from, position to,
+			const screen_cell* row, std::uint32_t style) const;
+
+		/**
+		 @returns The number of bytes 'repeat()' writes for `count`
+		          characters, or UNAVAILABLE
+		*/
+		[[nodiscard]] unsigned get_repeat_cost(unsigned count) const;
+
+		/**
+		 Writes `ch` `count` times with repeat_char
+		*/
+		void repeat(OutputBuffer& buf, char ch, unsigned count) const;
+
+		/**
+		 Allows repeat_char, for terminals known to implement it (off by
+		 default). Applies to every encoder.
+		*/
+		static void set_repeat_enabled(bool enabled) noexcept;
+
+		/**
+		 @returns The number of bytes 'erase_line()' writes, or UNAVAILABLE
+		*/
+		[[nodiscard]] unsigned get_erase_cost() const noexcept
+		{
+			return el_.empty() ? UNAVAILABLE : static_cast<unsigned>(el_.size());
+		}
+
+		/**
+		 Clears from the cursor to the end of the row, leaving the cursor
+		*/
+		void erase_line(OutputBuffer& buf) const { buf.append(el_); }
+
+		/**
+		 Writes the UTF-8 bytes of a cell's glyph
+		*/
+		static void put_glyph(OutputBuffer& buf, std::uint32_t glyph)
+		{
+			for (; glyph != 0; glyph >>= 8)
+				buf.append(static_cast<char>(glyph & 0xFF));
+		}
+
+	private:
+		enum param_cap : unsigned char
+		{
+			cup_row,   // cursor_address, by row (column 0)
+			cup_col,   // cursor_address, the extra cost by column
+			hpa,       // column_address
+			vpa,       // row_address
+			cuf,       // parm_right_cursor
+			cub,       // parm_left_cursor
+			cuu,       // parm_up_cursor
+			cud,       // parm_down_cursor
+			rep,       // repeat_char
+			PARAM_CAP_COUNT
+		};
+
+		enum class vertical : unsigned char { none, parm, single, address };
+		enum class horizontal : unsigned char { none, parm, single, address, rewrite };
+		enum class strategy : unsigned char { absolute, relative, carriage_return, newline };
+
+		struct plan
+		{
+			unsigned cost;
+			strategy how;
+			vertical v;
+			horizontal h;
+		};
+
+		static inline std::atomic<bool> s_repeat_enabled{ false };
+
+		std::string caps_[PARAM_CAP_COUNT];
+		std::vector<unsigned> costs_[PARAM_CAP_COUNT];
+		std::string cr_, cub1_, cuf1_, cuu1_, cud1_, el_;
+
+		[[nodiscard]] unsigned get_cost(param_cap cap, unsigned param) const;
+		[[nodiscard]] unsigned get_vertical(unsigned from_y, unsigned to_y, vertical& v) const;
+		[[nodiscard]] unsigned get_horizontal(unsigned from_x, unsigned to_x,
+			const screen_cell* row, std::uint32_t style, horizontal& h) const;
+		[[nodiscard]] plan get_plan(position from, position to,
+			const screen_cell* row, std::uint32_t style) const;
+
+		void put_vertical(OutputBuffer& buf, unsigned from_y, unsigned to_y, vertical v) const;
+		void put_horizontal(OutputBuffer& buf, unsigned from_x, unsigned to_x,
+			const screen_cell* row, horizontal h) const;
+	};
+} // namespace cons
+#endif // !CONS_OUTPUT_ENCODER_HEADER__
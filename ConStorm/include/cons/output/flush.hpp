@@ -0,0 +1,60 @@
+/*
+ Code by Drake Johnson
+
+ Defines the 'FlushPolicy' enum, which controls when buffered output is
+ written to its OutputSink, and the functions that set and apply it.
+*/
+#ifndef CONS_OUTPUT_FLUSH_HEADER__
+#define CONS_OUTPUT_FLUSH_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+
+namespace cons
+{
+	/**
+	 When the output gathered in a thread's OutputBuffer is written to its
+	 sink. Every policy writes when 'cons::print()' is called with no
+	 arguments, when 'cons::flush_async()' is called, when an OutputFrame
+	 constructed with its own sink closes, and when the thread exits.
+	*/
+	enum class FlushPolicy
+	{
+		immediate, // Every OutputFrame writes when it closes, even nested ones
+		on_frame,  // The outermost OutputFrame writes when it closes (default)
+		on_input,  // Output is held until the program blocks on std::cin
+		manual     // Output is held until it is flushed explicitly
+	};
+
+	/**
+	 Sets the flush policy for the whole program. Also ties std::cin to the
+	 output buffer, so that reading std::cin directly (not only through
+	 'cons::input()') writes pending output first under 'on_input'.
+
+	 Works with either setting of std::ios_base::sync_with_stdio: anything
+	 written to std::cout, or to C stdio when synchronized, is flushed before
+	 the buffered output so that the two stay in order.
+
+	 Example usage:
+	 @code
+		 cons::set_flush_policy(cons::FlushPolicy::on_input);
+		 cons::menu_loop(&main_menu); // One write per menu, just before input
+	 @endcode
+
+	 @param policy The new policy
+	*/
+	void set_flush_policy(FlushPolicy policy);
+
+	/**
+	 @returns The current flush policy
+	*/
+	[[nodiscard]] FlushPolicy get_flush_policy() noexcept;
+
+	/**
+	 Called just before the library blocks on std::cin. Writes the calling
+	 thread's pending output, and waits for it to be delivered, unless the
+	 policy is 'manual'.
+	*/
+	void flush_before_input();
+} // namespace cons
+#endif // !CONS_OUTPUT_FLUSH_HEADER__
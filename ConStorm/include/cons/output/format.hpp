@@ -0,0 +1,716 @@
+/*
+ Code by Drake Johnson
+
+ Defines 'cons::format()', 'cons::fmt()', and 'cons::printf_line()', which
+ format their arguments according to a format string. Format strings are
+ wrapped in the CONS_FMT macro so that they are parsed and validated at
+ compile time; at runtime, only the arguments themselves are written.
+
+ The format string syntax is a subset of std::format's:
+   {[index][:[[fill]align][sign][#][0][width][.precision][type]]}
+     - index     : Position of the argument to format (all or none given)
+     - fill      : Any character other than '{' or '}' (default ' ')
+     - align     : '<' left, '>' right, '^' center
+     - sign      : '+' always, '-' negatives only, ' ' space for positives
+     - #         : Prefix integers with '0x', '0o' or '0b'
+     - 0         : Pad numbers with zeros after the sign and prefix
+     - width     : Minimum number of columns. Each UTF-8 character is one
+                   column, and escape sequences (colors) are none.
+     - precision : Digits for floating point (at most 100), max characters
+                   for strings
+     - type      : d x X o b B c (integers and chars), f F e E g G
+                   (floating point), s (strings and bools)
+   '{{' and '}}' print a literal brace.
+
+ Header includes:
+   - formatter.hpp : formatter, format_to()
+     - buffer.hpp  : OutputBuffer, OutputFrame
+   - <array>       : array
+   - <charconv>    : to_chars
+   - <stdexcept>   : logic_error
+   - <string>      : string
+   - <string_view> : string_view
+   - <tuple>       : tuple, get
+   - <type_traits> : is_integral, is_floating_point
+   - <utility>     : index_sequence
+*/
+#ifndef CONS_OUTPUT_FORMAT_HEADER__
+#define CONS_OUTPUT_FORMAT_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include "formatter.hpp"
+#include <array>
+#include <charconv>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace cons
+{
+	namespace detail
+	{
+		/**
+		 Base of every type created by CONS_FMT
+		*/
+		struct format_string_tag {};
+	} // namespace detail
+} // namespace cons
+
+/**
+ Wraps a string literal so it can be used as a compile-time format string.
+
+ Example usage:
+ @code
+	 const auto str = cons::format(CONS_FMT("{:>8} {:.3f}"), "pi", 3.14159);
+	 cons::printf_line(CONS_FMT("{0} + {0} = {1}"), 2, 4);
+	 cons::print(cons::fmt(CONS_FMT("{:08.2f}"), 1.5), "next line");
+ @endcode
+*/
+#define CONS_FMT(str)                                                       \
+	([] {                                                                   \
+		struct cons_format_string_ : ::cons::detail::format_string_tag      \
+		{                                                                   \
+			static constexpr ::std::string_view value() { return str; }     \
+		};                                                                  \
+		return cons_format_string_{};                                       \
+	}())
+
+namespace cons
+{
+	/**
+	 Thrown during compile-time parsing of an invalid format string. As the
+	 parsing happens in a constant expression, this surfaces as a compile
+	 error that points at the throw with its message.
+	*/
+	struct FormatStringException : std::logic_error
+	{
+		using std::logic_error::logic_error;
+	};
+
+	namespace detail
+	{
+		constexpr size_t FMT_NO_ARG = static_cast<size_t>(-1);
+
+		/**
+		 The largest precision allowed for floating point values, and a
+		 buffer which always holds one in scientific notation: the sign,
+		 the digits, the point, and an exponent of up to five digits
+		*/
+		constexpr int FMT_MAX_FLOAT_PRECISION = 100;
+		constexpr size_t FMT_FLOAT_BUFFER_SIZE = FMT_MAX_FLOAT_PRECISION + 16;
+
+		enum class fmt_align : char
+		{
+			none,
+			left,
+			right,
+			center
+		};
+
+		/**
+		 One piece of a parsed format string: either literal text or one
+		 replacement field. For a replacement field, `lit_begin` is the
+		 position of its opening brace.
+		*/
+		struct fmt_segment
+		{
+			size_t lit_begin = 0;
+			size_t lit_size = 0;
+			size_t arg = FMT_NO_ARG;
+			char fill = ' ';
+			fmt_align align = fmt_align::none;
+			char sign = '-';
+			bool alt = false;
+			bool zero = false;
+			size_t width = 0;
+			int precision = -1;
+			char type = '\0';
+		};
+
+		/**
+		 Parses a format string into segments. When `segs` is nullptr, only
+		 counts the segments.
+		*/
+		class fmt_parser
+		{
+		public:
+			constexpr fmt_parser(const std::string_view str, fmt_segment* segs)
+				: str_(str), segs_(segs), count_(0), next_arg_(0), manual_(0)
+			{}
+
+			constexpr size_t run()
+			{
+				size_t pos = 0;
+				size_t lit_begin = 0;
+
+				while (pos < str_.size())
+				{
+					const auto ch = str_[pos];
+					if (ch == '{' && pos + 1 < str_.size() && str_[pos + 1] == '{')
+					{ // Escaped brace: keep the first, skip the second
+						add_literal(lit_begin, pos + 1);
+						pos += 2;
+						lit_begin = pos;
+					}
+					else if (ch == '}')
+					{
+						if (pos + 1 >= str_.size() || str_[pos + 1] != '}')
+							throw FormatStringException("unmatched '}' in format string");
+						add_literal(lit_begin, pos + 1);
+						pos += 2;
+						lit_begin = pos;
+					}
+					else if (ch == '{')
+					{
+						add_literal(lit_begin, pos);
+						pos = parse_field(pos + 1);
+						lit_begin = pos;
+					}
+					else
+						++pos;
+				}
+				add_literal(lit_begin, pos);
+
+				return count_;
+			}
+
+		private:
+			std::string_view str_;
+			fmt_segment* segs_;
+			size_t count_;
+			size_t next_arg_;
+			int manual_; // 0: unknown, 1: automatic indexing, 2: manual indexing
+
+			constexpr void add(const fmt_segment& seg)
+			{
+				if (segs_ != nullptr)
+					segs_[count_] = seg;
+				++count_;
+			}
+
+			constexpr void add_literal(const size_t begin, const size_t end)
+			{
+				if (end <= begin)
+					return;
+
+				fmt_segment seg;
+				seg.lit_begin = begin;
+				seg.lit_size = end - begin;
+				add(seg);
+			}
+
+			[[nodiscard]] constexpr char at(const size_t pos) const
+			{
+				if (pos >= str_.size())
+					throw FormatStringException("unterminated replacement field");
+				return str_[pos];
+			}
+
+			[[nodiscard]] static constexpr bool is_digit(const char ch)
+			{
+				return ch >= '0' && ch <= '9';
+			}
+
+			[[nodiscard]] static constexpr bool is_align(const char ch)
+			{
+				return ch == '<' || ch == '>' || ch == '^';
+			}
+
+			[[nodiscard]] static constexpr fmt_align to_align(const char ch)
+			{
+				return ch == '<' ? fmt_align::left
+					: ch == '>' ? fmt_align::right : fmt_align::center;
+			}
+
+			constexpr size_t parse_number(size_t& pos) const
+			{
+				size_t value = 0;
+				while (is_digit(at(pos)))
+				{
+					value = value * 10 + static_cast<size_t>(at(pos) - '0');
+					if (value > 0xFFFF)
+						throw FormatStringException("number too large in format spec");
+					++pos;
+				}
+				return value;
+			}
+
+			constexpr size_t parse_field(size_t pos)
+			{
+				fmt_segment seg;
+				seg.lit_begin = pos - 1;
+
+				// Argument index
+				if (is_digit(at(pos)))
+				{
+					if (manual_ == 1)
+						throw FormatStringException(
+							"cannot mix automatic and manual argument indexing");
+					manual_ = 2;
+					seg.arg = parse_number(pos);
+				}
+				else
+				{
+					if (manual_ == 2)
+						throw FormatStringException(
+							"cannot mix automatic and manual argument indexing");
+					manual_ = 1;
+					seg.arg = next_arg_++;
+				}
+
+				if (at(pos) == ':')
+					pos = parse_spec(pos + 1, seg);
+
+				if (at(pos) != '}')
+					throw FormatStringException("invalid replacement field");
+
+				add(seg);
+				return pos + 1;
+			}
+
+			constexpr size_t parse_spec(size_t pos, fmt_segment& seg)
+			{
+				// [[fill]align]
+				if (pos + 1 < str_.size() && is_align(str_[pos + 1]) &&
+					str_[pos] != '{' && str_[pos] != '}')
+				{
+					seg.fill = str_[pos];
+					seg.align = to_align(str_[pos + 1]);
+					pos += 2;
+				}
+				else if (is_align(at(pos)))
+				{
+					seg.align = to_align(at(pos));
+					++pos;
+				}
+
+				// [sign]
+				if (at(pos) == '+' || at(pos) == '-' || at(pos) == ' ')
+				{
+					seg.sign = at(pos);
+					++pos;
+				}
+
+				// [#]
+				if (at(pos) == '#')
+				{
+					seg.alt = true;
+					++pos;
+				}
+
+				// [0]
+				if (at(pos) == '0')
+				{
+					seg.zero = true;
+					++pos;
+				}
+
+				// [width]
+				if (is_digit(at(pos)))
+					seg.width = parse_number(pos);
+
+				// [.precision]
+				if (at(pos) == '.')
+				{
+					++pos;
+					if (!is_digit(at(pos)))
+						throw FormatStringException("missing precision after '.'");
+					seg.precision = static_cast<int>(parse_number(pos));
+				}
+
+				// [type]
+				if (at(pos) != '}')
+				{
+					seg.type = at(pos);
+					++pos;
+				}
+
+				return pos;
+			}
+		};
+
+		template <class FmtStr>
+		/**
+		 Holds the parsed segments of a CONS_FMT format string
+		*/
+		struct fmt_segments
+		{
+			static_assert(std::is_base_of_v<format_string_tag, FmtStr>,
+				"Format strings must be wrapped in CONS_FMT()");
+
+			static constexpr size_t size = fmt_parser(FmtStr::value(), nullptr).run();
+
+			static constexpr std::array<fmt_segment, size> parse()
+			{
+				std::array<fmt_segment, size> segs{};
+				fmt_parser(FmtStr::value(), segs.data()).run();
+				return segs;
+			}
+
+			static constexpr std::array<fmt_segment, size> value = parse();
+		};
+
+		enum class fmt_category
+		{
+			integer,
+			floating,
+			character,
+			boolean,
+			string,
+			other
+		};
+
+		template <class Ty>
+		constexpr fmt_category fmt_category_of()
+		{
+			using value_type = std::remove_cv_t<std::remove_reference_t<Ty>>;
+
+			if constexpr (std::is_same_v<value_type, bool>)
+				return fmt_category::boolean;
+			else if constexpr (std::is_same_v<value_type, char>)
+				return fmt_category::character;
+			else if constexpr (std::is_integral_v<value_type>)
+				return fmt_category::integer;
+			else if constexpr (std::is_floating_point_v<value_type>)
+				return fmt_category::floating;
+			else if constexpr (std::is_convertible_v<const value_type&, std::string_view>)
+				return fmt_category::string;
+			else
+				return fmt_category::other;
+		}
+
+		constexpr bool fmt_type_in(const char type, const std::string_view allowed)
+		{
+			return type == '\0' || allowed.find(type) != std::string_view::npos;
+		}
+
+		template <class... Args, size_t Size>
+		/**
+		 Checks every replacement field of a parsed format string against the
+		 types of the arguments it will be given
+		*/
+		constexpr bool check_format(const std::array<fmt_segment, Size>& segs)
+		{
+			constexpr fmt_category categories[] = {
+				fmt_category_of<Args>()..., fmt_category::other
+			};
+
+			for (const auto& seg : segs)
+			{
+				if (seg.arg == FMT_NO_ARG)
+					continue;
+				if (seg.arg >= sizeof...(Args))
+					throw FormatStringException("argument index out of range");
+
+				const auto category = categories[seg.arg];
+				const auto numeric = category == fmt_category::integer ||
+					category == fmt_category::floating ||
+					(category == fmt_category::character &&
+						seg.type != '\0' && seg.type != 'c');
+
+				if (!numeric && (seg.sign != '-' || seg.alt || seg.zero))
+					throw FormatStringException(
+						"sign, '#' and '0' are only valid for numbers");
+
+				switch (category)
+				{
+				case fmt_category::integer:
+				case fmt_category::character:
+					if (!fmt_type_in(seg.type, "dxXobBc"))
+						throw FormatStringException("invalid type for an integer");
+					if (seg.precision >= 0)
+						throw FormatStringException("precision not allowed for integers");
+					break;
+
+				case fmt_category::floating:
+					if (!fmt_type_in(seg.type, "fFeEgG"))
+						throw FormatStringException("invalid type for a floating point value");
+					if (seg.alt)
+						throw FormatStringException("'#' not allowed for floating point");
+					if (seg.precision > FMT_MAX_FLOAT_PRECISION)
+						throw FormatStringException("precision too large for floating point");
+					break;
+
+				case fmt_category::boolean:
+					if (!fmt_type_in(seg.type, "s"))
+						throw FormatStringException("invalid type for a bool");
+					if (seg.precision >= 0)
+						throw FormatStringException("precision not allowed for bools");
+					break;
+
+				case fmt_category::string:
+					if (!fmt_type_in(seg.type, "s"))
+						throw FormatStringException("invalid type for a string");
+					break;
+
+				default:
+					if (seg.type != '\0')
+						throw FormatStringException("type not allowed for this argument");
+					if (seg.precision >= 0)
+						throw FormatStringException("precision not allowed for this argument");
+					break;
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		 Pads the text appended since `begin` to the width of `seg`, counting
+		 columns rather than bytes
+		*/
+		void fmt_pad(OutputBuffer& buf, size_t begin, const fmt_segment& seg,
+			fmt_align default_align);
+
+		/**
+		 Writes an integer's magnitude with the sign, prefix, and padding
+		 described by `seg`
+		*/
+		void fmt_write_integer(OutputBuffer& buf, unsigned long long magnitude,
+			bool negative, const fmt_segment& seg);
+
+		/**
+		 Writes a floating point value (already converted into `digits` with
+		 its sign) with the sign, case, and padding described by `seg`
+		*/
+		void fmt_write_floating(OutputBuffer& buf, const char* digits,
+			size_t size, const fmt_segment& seg);
+
+		/**
+		 @returns The number of bytes in the first `count` UTF-8 characters
+		          of `str`
+		*/
+		size_t fmt_prefix_size(std::string_view str, size_t count) noexcept;
+
+		template <class Ty>
+		void fmt_write_arg(OutputBuffer& buf, const Ty& value, const fmt_segment& seg)
+		{
+			constexpr auto category = fmt_category_of<Ty>();
+
+			// A reset held back from the previous argument is not part of
+			// this one, and padding must not land before it
+			if (seg.width > 0)
+				buf.commit_reset();
+
+			if constexpr (category == fmt_category::integer ||
+				category == fmt_category::character)
+			{
+				if (seg.type == 'c' ||
+					(category == fmt_category::character && seg.type == '\0'))
+				{
+					const auto begin = buf.size();
+					buf.append(static_cast<char>(value));
+					fmt_pad(buf, begin, seg, fmt_align::left);
+				}
+				else if constexpr (std::is_signed_v<Ty>)
+				{
+					const auto wide = static_cast<long long>(value);
+					const auto magnitude = wide < 0
+						? 0ULL - static_cast<unsigned long long>(wide)
+						: static_cast<unsigned long long>(wide);
+					fmt_write_integer(buf, magnitude, wide < 0, seg);
+				}
+				else
+					fmt_write_integer(buf, static_cast<unsigned long long>(value), false, seg);
+			}
+			else if constexpr (category == fmt_category::floating)
+			{
+				char digits[FMT_FLOAT_BUFFER_SIZE];
+				std::to_chars_result result{ digits, std::errc() };
+
+				const auto precision = seg.precision >= 0 ? seg.precision : 6;
+				switch (seg.type)
+				{
+				case 'f': case 'F':
+					result = std::to_chars(digits, digits + sizeof(digits), value,
+						std::chars_format::fixed, precision);
+					break;
+				case 'e': case 'E':
+					result = std::to_chars(digits, digits + sizeof(digits), value,
+						std::chars_format::scientific, precision);
+					break;
+				default:
+					result = std::to_chars(digits, digits + sizeof(digits), value,
+						std::chars_format::general, precision);
+					break;
+				}
+
+				if (result.ec != std::errc())
+				{ // Too long for a fixed representation; fall back
+					result = std::to_chars(digits, digits + sizeof(digits), value,
+						std::chars_format::scientific, precision);
+				}
+
+				// The fallback always fits, given the bounded precision;
+				// nothing is written if it somehow does not
+				const auto size = result.ec == std::errc()
+					? static_cast<size_t>(result.ptr - digits) : 0;
+				fmt_write_floating(buf, digits, size, seg);
+			}
+			else if constexpr (category == fmt_category::boolean)
+			{
+				const auto begin = buf.size();
+				buf.append(value ? std::string_view("true") : std::string_view("false"));
+				fmt_pad(buf, begin, seg, fmt_align::left);
+			}
+			else if constexpr (category == fmt_category::string)
+			{
+				auto str = std::string_view(value);
+				if (seg.precision >= 0)
+					str = str.substr(0, fmt_prefix_size(str, static_cast<size_t>(seg.precision)));
+
+				const auto begin = buf.size();
+				buf.append(str);
+				fmt_pad(buf, begin, seg, fmt_align::left);
+			}
+			else
+			{
+				const auto begin = buf.size();
+				format_to(buf, value);
+				fmt_pad(buf, begin, seg, fmt_align::left);
+			}
+		}
+
+		template <class FmtStr, size_t Index, class Tuple>
+		void fmt_write_segment(OutputBuffer& buf, const Tuple& args)
+		{
+			constexpr auto& seg = fmt_segments<FmtStr>::value[Index];
+
+			if constexpr (seg.arg == FMT_NO_ARG)
+				buf.append(FmtStr::value().substr(seg.lit_begin, seg.lit_size));
+			else
+				fmt_write_arg(buf, std::get<seg.arg>(args), seg);
+		}
+
+		/**
+		 Lends 'format()' an OutputBuffer kept by the calling thread, so that
+		 formatting into a string allocates nothing but the result. A format
+		 nested inside another (from a formatter) gets a buffer of its own.
+
+		 @param buf_ The lent buffer, empty and in the default attributes
+		*/
+		class fmt_scratch
+		{
+		public:
+			fmt_scratch();
+			fmt_scratch(const fmt_scratch&) = delete;
+			fmt_scratch& operator=(const fmt_scratch&) = delete;
+			~fmt_scratch();
+
+			[[nodiscard]] OutputBuffer& get() const noexcept { return *buf_; }
+
+		private:
+			OutputBuffer* buf_;
+		};
+
+		template <class FmtStr, class Tuple, size_t... Indices>
+		void fmt_write_all(OutputBuffer& buf, const Tuple& args,
+			std::index_sequence<Indices...>)
+		{
+			(fmt_write_segment<FmtStr, Indices>(buf, args), ...);
+		}
+	} // namespace detail
+
+	template <class FmtStr, class... Args>
+	/**
+	 Appends `args` to `buf`, formatted according to the format string. The
+	 format string is checked against the argument types at compile time.
+
+	 @param buf  The OutputBuffer to append to
+	 @param args The arguments referred to by the format string
+	*/
+	void format_into(OutputBuffer& buf, FmtStr, const Args&... args)
+	{
+		using segments = detail::fmt_segments<FmtStr>;
+		static_assert(detail::check_format<Args...>(segments::value),
+			"Invalid format string");
+
+		detail::fmt_write_all<FmtStr>(buf, std::forward_as_tuple(args...),
+			std::make_index_sequence<segments::size>{});
+	}
+
+	template <class FmtStr, class... Args>
+	/**
+	 A formatted line which has not been written yet. Holds references to its
+	 arguments, so it must be printed before they go out of scope. Created by
+	 'cons::fmt()' and printable through cons::print() and cons::prompt().
+
+	 @param args_ References to the arguments to format
+	*/
+	class formatted
+	{
+	public:
+		explicit formatted(const Args&... args) : args_(args...) {}
+
+		void write(OutputBuffer& buf) const
+		{
+			std::apply([&buf](const Args&... args)
+			{
+				format_into(buf, FmtStr{}, args...);
+			}, args_);
+		}
+
+	private:
+		std::tuple<const Args&...> args_;
+	};
+
+	template <class FmtStr, class... Args>
+	struct formatter<formatted<FmtStr, Args...>>
+	{
+		static void format(OutputBuffer& buf, const formatted<FmtStr, Args...>& value)
+		{
+			value.write(buf);
+		}
+	};
+
+	template <class FmtStr, class... Args>
+	/**
+	 Creates a formatted line for use as an argument to cons::print() or
+	 cons::prompt(). The arguments are written straight into the output
+	 buffer when the line is printed.
+
+	 @param args The arguments referred to by the format string
+	 @returns An object which formats `args` when printed
+	*/
+	[[nodiscard]] formatted<FmtStr, Args...> fmt(FmtStr, const Args&... args)
+	{
+		return formatted<FmtStr, Args...>(args...);
+	}
+
+	template <class FmtStr, class... Args>
+	/**
+	 Formats `args` according to the format string into a new std::string.
+	 The text is built in a buffer the calling thread reuses.
+
+	 @param args The arguments referred to by the format string
+	 @returns The formatted string
+	*/
+	[[nodiscard]] std::string format(FmtStr fmt_str, const Args&... args)
+	{
+		detail::fmt_scratch scratch;
+		auto& buf = scratch.get();
+		format_into(buf, fmt_str, args...);
+		buf.reset_attributes();
+		return std::string(buf.data(), buf.size());
+	}
+
+	template <class FmtStr, class... Args>
+	/**
+	 Formats `args` according to the format string and prints the result on
+	 its own line, like a single argument to cons::print()
+
+	 @param args The arguments referred to by the format string
+	*/
+	void printf_line(FmtStr fmt_str, const Args&... args)
+	{
+		OutputFrame frame;
+		auto& buf = out();
+		format_into(buf, fmt_str, args...);
+		buf.append('\n');
+	}
+} // namespace cons
+#endif // !CONS_OUTPUT_FORMAT_HEADER__
@@ -0,0 +1,219 @@
+/*
+ Code by Drake Johnson
+
+ Defines the 'formatter' customization point. A formatter appends the text of
+ a value directly to an OutputBuffer, without going through std::ostream.
+ Arithmetic types and strings have built-in formatters; every other type is
+ formatted by its 'println' specialization through an adapter, so existing
+ specializations of 'println' keep working. The adapter writes into the
+ buffer it is given, like every other formatter.
+
+ Header includes:
+   - buffer.hpp     : OutputBuffer
+   - <charconv>     : to_chars
+   - <string>       : string
+   - <string_view>  : string_view
+   - <type_traits>  : is_integral, is_floating_point, is_base_of
+*/
+#ifndef CONS_OUTPUT_FORMATTER_HEADER__
+#define CONS_OUTPUT_FORMATTER_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include "buffer.hpp"
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace cons
+{
+	// Defined in "println/master.hpp"
+	template <class LnTy, class = void>
+	class println;
+
+	namespace detail
+	{
+		/**
+		 Base of the primary 'formatter' template. Used to tell whether a type
+		 has a formatter of its own.
+		*/
+		struct println_adapter {};
+
+		/**
+		 While an object of this class exists, 'out()' is `buf` on the
+		 calling thread, which sends the 'println' specialization being
+		 adapted into the buffer being formatted. Nothing global is changed,
+		 so other threads are unaffected.
+
+		 @param prev_target_ What 'out()' returned before
+		*/
+		class println_redirect
+		{
+		public:
+			explicit println_redirect(OutputBuffer& buf);
+			println_redirect(const println_redirect&) = delete;
+			println_redirect& operator=(const println_redirect&) = delete;
+			~println_redirect();
+
+		private:
+			OutputBuffer* prev_target_;
+		};
+	} // namespace detail
+
+	template <class Ty, class = void>
+	/**
+	 Appends the text of a value of type 'Ty' to an OutputBuffer. Specialize
+	 this struct to add fast, buffer-based printing for a type:
+	 @code
+		 namespace cons
+		 {
+			 template <>
+			 struct formatter<Point>
+			 {
+				 static void format(OutputBuffer& buf, const Point& pt)
+				 {
+					 buf.append('(');
+					 formatter<int>::format(buf, pt.x);
+					 buf.append(", ");
+					 formatter<int>::format(buf, pt.y);
+					 buf.append(')');
+				 }
+			 };
+		 }
+	 @endcode
+
+	 The primary template is an adapter which formats the value with
+	 'println<Ty>', with 'out()' returning the buffer while it runs. A
+	 'println' specialization must therefore write to 'out()' (or
+	 'out().stream()'), never to std::cout.
+	*/
+	struct formatter : detail::println_adapter
+	{
+		static void format(OutputBuffer& buf, const Ty& value)
+		{
+			detail::println_redirect redirect(buf);
+			println<Ty> p(value);
+		}
+	};
+
+	template <class Ty>
+	/**
+	 'true' if 'Ty' has a formatter of its own instead of the 'println' adapter
+	*/
+	inline constexpr bool has_formatter_v =
+		!std::is_base_of_v<detail::println_adapter, formatter<Ty>>;
+
+	template <class Ty>
+	/**
+	 Formatter for integral types (except bool and the character types) using
+	 std::to_chars
+	*/
+	struct formatter<Ty, std::enable_if_t<std::is_integral_v<Ty> &&
+		!std::is_same_v<Ty, bool> && !std::is_same_v<Ty, char> &&
+		!std::is_same_v<Ty, signed char> && !std::is_same_v<Ty, unsigned char>>>
+	{
+		static void format(OutputBuffer& buf, const Ty value)
+		{
+			char digits[24];
+			const auto result = std::to_chars(digits,
+				digits + sizeof(digits), value);
+			buf.append(digits, static_cast<size_t>(result.ptr - digits));
+		}
+	};
+
+	template <class Ty>
+	/**
+	 Formatter for floating point types using std::to_chars. The output
+	 matches std::ostream's default formatting (six significant digits).
+	*/
+	struct formatter<Ty, std::enable_if_t<std::is_floating_point_v<Ty>>>
+	{
+		static constexpr int DEFAULT_PRECISION = 6;
+
+		static void format(OutputBuffer& buf, const Ty value)
+		{
+			char digits[64];
+			const auto result = std::to_chars(digits,
+				digits + sizeof(digits), value, std::chars_format::general,
+				DEFAULT_PRECISION);
+			buf.append(digits, static_cast<size_t>(result.ptr - digits));
+		}
+	};
+
+	template <class Ty>
+	/**
+	 Formatter for the character types. The character itself is printed, as
+	 with std::ostream.
+	*/
+	struct formatter<Ty, std::enable_if_t<std::is_same_v<Ty, char> ||
+		std::is_same_v<Ty, signed char> || std::is_same_v<Ty, unsigned char>>>
+	{
+		static void format(OutputBuffer& buf, const Ty value)
+		{
+			buf.append(static_cast<char>(value));
+		}
+	};
+
+	template <>
+	/**
+	 Formatter for bool. Prints '1' or '0', as with std::ostream.
+	*/
+	struct formatter<bool>
+	{
+		static void format(OutputBuffer& buf, const bool value)
+		{
+			buf.append(value ? '1' : '0');
+		}
+	};
+
+	template <>
+	struct formatter<std::string_view>
+	{
+		static void format(OutputBuffer& buf, const std::string_view value)
+		{
+			buf.append(value);
+		}
+	};
+
+	template <>
+	struct formatter<std::string>
+	{
+		static void format(OutputBuffer& buf, const std::string& value)
+		{
+			buf.append(value);
+		}
+	};
+
+	template <>
+	struct formatter<const char*>
+	{
+		static void format(OutputBuffer& buf, const char* const value)
+		{
+			buf.append(std::string_view(value));
+		}
+	};
+
+	template <>
+	struct formatter<char*> : formatter<const char*> {};
+
+	template <class Ty>
+	/**
+	 Appends the text of `value` to `buf` using the formatter for its type.
+	 Character arrays (string literals) are formatted as C strings.
+
+	 @param buf   The OutputBuffer to append to
+	 @param value The value to format
+	*/
+	void format_to(OutputBuffer& buf, const Ty& value)
+	{
+		if constexpr (std::is_array_v<Ty> &&
+			std::is_same_v<std::remove_cv_t<std::remove_extent_t<Ty>>, char>)
+			formatter<const char*>::format(buf, value);
+		else
+			formatter<std::remove_cv_t<Ty>>::format(buf, value);
+	}
+} // namespace cons
+
+#include "println/master.hpp"
+#endif // !CONS_OUTPUT_FORMATTER_HEADER__
@@ -1,12 +1,19 @@
 /*
  Code by Drake Johnson
 
- Displays multi-colored text in a windows console
+ Displays multi-colored text in a console. The cursor is moved by the
+ console backend (see backend.hpp).
+
+ Header includes:
+   - print.hpp : textf, OutputBuffer
+   - <cstdint> : uint64_t
+   - <string>  : string
 */
 #ifndef CONS_HEADER_HEADER__
 #define CONS_HEADER_HEADER__
 #include "print.hpp"
-#ifdef _WIN32
+#include <cstdint>
+#include <string>
 
 namespace cons
 {
@@ -26,6 +33,11 @@ namespace cons
 
 	 After `display()` is called, the cursor will be moved to the next line.
 
+	 The header is rendered once into a byte sequence, which is reused until
+	 a setter changes its text, color, or position. The underline is placed
+	 with a cursor movement relative to the end of the title, so the console
+	 is never asked where its cursor is.
+
 	 Example usage:
 	 @code
 	 // Create Header object
@@ -53,7 +65,10 @@ namespace cons
 			mutable unsigned X;
 			mutable unsigned Y;
 
-			[[nodiscard]] COORD get_short() const;
+			constexpr U_COORD(const unsigned x = 0, const unsigned y = 0) noexcept
+				: X(x), Y(y)
+			{}
+			U_COORD(const U_COORD&) = default;
 
 			U_COORD& operator=(U_COORD other);
 			bool operator==(U_COORD other);
@@ -63,6 +78,7 @@ namespace cons
 		Header(std::string text = "");
 
 		void display() const override;
+		void display(OutputBuffer& buf) const override;
 
 		void set_console_cursor(U_COORD position);
 		void set_console_cursor(unsigned x, unsigned y);
@@ -77,19 +93,37 @@ namespace cons
 		// std::string_view text_;  //
 		// ConsoleColor color_;     //
 
+		/**
+		 The bytes of the last display. The setters clear `valid`.
+
+		 @param valid      Whether the bytes match the header
+		 @param attributes The attribute id of the colors
+		 @param styled     Whether the bytes hold cursor movement
+		 @param sequence   The escape sequence which sets the colors
+		 @param body       The title, the cursor movement, and the underline
+		*/
+		struct render_cache
+		{
+			bool valid = false;
+			std::uint64_t attributes = 0;
+			bool styled = false;
+			std::string sequence;
+			std::string body;
+		};
+
 		mutable U_COORD cursor_location_;
-		bool update_cursor_;
+		mutable render_cache cache_;
 
-		static U_COORD get_console_cursor_pos();
 		static U_COORD get_live_console_cursor();
 
-		[[nodiscard]] WORD setup_console() const override;
-		void restore_console(WORD old_attribs) const override;
+		/**
+		 @returns The cached bytes, rebuilt if the header has changed since
+		          they were built
+		*/
+		const render_cache& get_rendered() const;
+
+		void setup_console(OutputBuffer& buf) const override;
+		void on_change() noexcept override { cache_.valid = false; }
 	};
 } // namespace cons
-#   else // Not Windows system
-	// NOTE: Only Windows is supported for this header!
-	// If not using Windows, this header should cause a linker
-	// error.
-#   endif // _WIN32
 #endif // !CONS_HEADER_HEADER__
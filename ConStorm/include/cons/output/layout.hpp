@@ -0,0 +1,257 @@
+/*
+ Code by Drake Johnson
+
+ Contains the Layout class, a retained tree of boxes which divides the
+ screen into rectangles for headers, wrapped text, and other content
+
+ Header includes:
+   - screen.hpp    : Screen, Header, WordWrap, StyledText, string_view
+   - <cstddef>     : size_t
+   - <vector>      : vector
+*/
+#ifndef CONS_OUTPUT_LAYOUT_HEADER__
+#define CONS_OUTPUT_LAYOUT_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include "screen.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace cons
+{
+	/**
+	 A rectangle of cells. In a Layout, 'x' and 'y' are relative to the
+	 parent's rectangle until read with 'Layout::get_rect()'.
+	*/
+	struct LayoutRect
+	{
+		unsigned x = 0;
+		unsigned y = 0;
+		unsigned width = 0;
+		unsigned height = 0;
+	};
+
+	/**
+	 How much of its parent a node takes, along the parent's direction: the
+	 height of a node in a column, the width of a node in a row. Across the
+	 parent's direction, a node always fills its parent.
+	*/
+	struct LayoutSize
+	{
+		enum class kind : unsigned char
+		{
+			content, // As much as the node's content needs
+			fixed,   // 'value' cells
+			flex     // A share of what is left, by the weight 'value'
+		};
+
+		kind type = kind::content;
+		unsigned value = 0;
+
+		[[nodiscard]] static constexpr LayoutSize content() noexcept { return { kind::content, 0 }; }
+		[[nodiscard]] static constexpr LayoutSize fixed(const unsigned cells) noexcept { return { kind::fixed, cells }; }
+		[[nodiscard]] static constexpr LayoutSize flex(const unsigned weight = 1) noexcept { return { kind::flex, weight }; }
+	};
+
+	/**
+	 The space inside a node's edges, or inside its border if it has one
+	*/
+	struct LayoutPadding
+	{
+		unsigned top = 0;
+		unsigned right = 0;
+		unsigned bottom = 0;
+		unsigned left = 0;
+	};
+
+	/**
+	 A tree of nodes, built once and kept, which is laid out into the
+	 rectangles its content is drawn in. Boxes arrange their children in a
+	 column (top to bottom) or a row (left to right), sized by LayoutSize,
+	 with padding and an optional border. The other nodes hold a Header,
+	 text which is wrapped to the node's width, or a slot: a rectangle of a
+	 given size for content the caller draws itself, such as menu options.
+
+	 Every node caches its measurements: its natural width, and its height
+	 at the last width it was measured at (with the wrapped lines, for
+	 text). Changing a node marks it and its ancestors dirty. 'update()'
+	 then measures only the dirty nodes, since every other node's cached
+	 measurement still holds, and lays out again only the nodes which are
+	 dirty or have changed size. Positions are kept relative to the parent,
+	 so a subtree which only moves is not laid out again.
+
+	 Example usage:
+	 @code
+	 cons::Layout layout;
+	 layout.add_header(cons::Layout::ROOT, cons::Header("Status"));
+	 const auto body = layout.add_box(cons::Layout::ROOT, cons::Layout::direction::row);
+	 const auto log = layout.add_text(body, cons::StyledText("Started."));
+	 layout.set_border(body, true);
+
+	 auto& screen = cons::Screen::get();
+	 screen.begin_frame();
+	 layout.update(screen.get_columns(), screen.get_rows());
+	 layout.draw(screen);
+	 screen.present();
+	 @endcode
+
+	 @param nodes_         The nodes, by id. The root is first.
+	 @param measure_count_ The number of measurements which were not cached
+	 @param arrange_count_ The number of nodes laid out
+	*/
+	class Layout
+	{
+	public:
+		enum class direction : unsigned char
+		{
+			column, // Children are stacked top to bottom
+			row     // Children are placed left to right
+		};
+
+		using node_id = unsigned;
+		static constexpr node_id ROOT = 0;
+
+		/**
+		 Creates a layout with only a root box, which fills the area given
+		 to 'update()'
+		*/
+		explicit Layout(direction root_direction = direction::column);
+
+		node_id add_box(node_id parent, direction dir, LayoutSize size = LayoutSize::flex());
+		node_id add_header(node_id parent, Header header, LayoutSize size = LayoutSize::content());
+
+		/**
+		 Adds text which is wrapped to the node's width, or to `char_count`
+		 if it is narrower (see WordWrap)
+		*/
+		node_id add_text(node_id parent, StyledText text,
+			unsigned char_count = WordWrap::TERMINAL_WIDTH, unsigned tab_spaces = 4U,
+			LayoutSize size = LayoutSize::content());
+		node_id add_text(node_id parent, const WordWrap& text, LayoutSize size = LayoutSize::content());
+
+		/**
+		 Adds a rectangle which needs `columns` by `rows` cells, for content
+		 drawn by the caller into 'get_rect()'
+		*/
+		node_id add_slot(node_id parent, unsigned columns, unsigned rows,
+			LayoutSize size = LayoutSize::content());
+
+		void set_size(node_id id, LayoutSize size);
+		void set_padding(node_id id, LayoutPadding padding);
+
+		/**
+		 Draws a one-cell border around a box, inside its rectangle
+		*/
+		void set_border(node_id id, bool border);
+
+		void set_header(node_id id, Header header);
+		void set_text(node_id id, StyledText text);
+		void set_text(node_id id, const WordWrap& text);
+
+		/**
+		 Sets the size a slot needs. Does nothing if it has not changed, so
+		 it may be called every frame.
+		*/
+		void set_slot(node_id id, unsigned columns, unsigned rows);
+
+		/**
+		 @returns The number of columns `str` takes, counting one per UTF-8
+		          character. Sizes a slot for text the caller draws.
+		*/
+		[[nodiscard]] static unsigned get_columns(std::string_view str) noexcept;
+
+		/**
+		 Lays out the tree in an area of `columns` by `rows` cells. Only the
+		 dirty parts of the tree, and the parts whose size changed, are
+		 measured and laid out again.
+
+		 @returns Whether any node was laid out again
+		*/
+		bool update(unsigned columns, unsigned rows);
+
+		/**
+		 @returns The node's rectangle on the screen, as of the last
+		          'update()'
+		*/
+		[[nodiscard]] LayoutRect get_rect(node_id id) const;
+
+		/**
+		 @returns The node's rectangle inside its border and padding
+		*/
+		[[nodiscard]] LayoutRect get_content_rect(node_id id) const;
+
+		/**
+		 Draws the borders, headers, and text into `screen`
+		*/
+		void draw(Screen& screen) const;
+
+		[[nodiscard]] size_t size() const noexcept { return nodes_.size(); }
+		[[nodiscard]] size_t get_measure_count() const noexcept { return measure_count_; }
+		[[nodiscard]] size_t get_arrange_count() const noexcept { return arrange_count_; }
+
+	private:
+		static constexpr unsigned UNMEASURED = ~0U;
+
+		enum class kind : unsigned char { box, header, text, slot };
+
+		/**
+		 @param dirty           Whether the node or a descendant changed since
+		                        it was laid out
+		 @param natural_width   The width the node needs to show its content
+		                        unwrapped, or UNMEASURED
+		 @param measured_width  The width 'measured_height' is for, or
+		                        UNMEASURED
+		 @param wrapped         The text's lines at 'measured_width'
+		 @param rect            The node's rectangle, relative to its parent's
+		*/
+		struct node
+		{
+			kind type;
+			direction dir = direction::column;
+			LayoutSize size;
+			LayoutPadding padding;
+			bool border = false;
+			node_id parent = ROOT;
+			std::vector<node_id> children;
+
+			Header header;
+			StyledText text;
+			unsigned char_count = WordWrap::TERMINAL_WIDTH;
+			unsigned tab_spaces = 4;
+			unsigned slot_columns = 0;
+			unsigned slot_rows = 0;
+
+			bool dirty = true;
+			unsigned natural_width = UNMEASURED;
+			unsigned measured_width = UNMEASURED;
+			unsigned measured_height = 0;
+			WordWrap wrapped{ "", 1 };
+			LayoutRect rect;
+		};
+
+		std::vector<node> nodes_;
+		size_t measure_count_ = 0;
+		size_t arrange_count_ = 0;
+
+		node_id add(node_id parent, node n);
+		void mark_dirty(node_id id);
+
+		[[nodiscard]] unsigned get_inset_width(const node& n) const noexcept;
+		[[nodiscard]] unsigned get_inset_height(const node& n) const noexcept;
+
+		unsigned measure_width(node_id id);
+		unsigned measure_height(node_id id, unsigned width);
+
+		/**
+		 Sizes the children of a box along its direction, within `length`
+		 cells, with `cross` cells across it
+		*/
+		void distribute(const node& box, unsigned length, unsigned cross,
+			std::vector<unsigned>& sizes);
+
+		bool arrange(node_id id, LayoutRect rect);
+		void draw(Screen& screen, node_id id, unsigned x, unsigned y) const;
+	};
+} // namespace cons
+#endif // !CONS_OUTPUT_LAYOUT_HEADER__
@@ -0,0 +1,132 @@
+/*
+ Code by Drake Johnson
+
+ Contains the LogPane class, an area of the terminal which lines are
+ appended to and scrolled by the terminal itself
+
+ Header includes:
+   - screen.hpp                  : Screen
+   - utilities/console/color.hpp : ConsoleColor
+   - <mutex>                     : mutex
+   - <string>                    : string
+   - <string_view>               : string_view
+   - <vector>                    : vector
+*/
+#ifndef CONS_OUTPUT_LOG_PANE_HEADER__
+#define CONS_OUTPUT_LOG_PANE_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include "screen.hpp"
+#include "../utilities/console/color.hpp"
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cons
+{
+	/**
+	 A live log in a band of rows of the terminal, such as under a menu.
+	 Appending a line scrolls the band up one row with a scroll region
+	 (DECSTBM; the console API on Windows) and writes the line into the row
+	 left blank, so each line costs one short write no matter how large the
+	 screen is. The cursor is put back where it was, and nothing outside
+	 the band changes.
+
+	 The band's rows are reserved on the terminal's screen (see
+	 'Screen::reserve_rows()'), which neither draws on nor clears them, and
+	 the pane's output does not make the screen repaint. The most recent
+	 lines are kept, so the band is repainted when the terminal is resized,
+	 or by 'repaint()'. When the output is not styled (see TerminalInfo),
+	 lines are printed one after another instead.
+
+	 Lines are cut off at the terminal's width. Lines may be appended from
+	 any thread, but the pane should be constructed and destroyed on the
+	 thread which draws the screen.
+
+	 Example usage:
+	 @code
+	 cons::LogPane log(14); // Rows 14 to the bottom
+	 log.append("Connected");
+	 log.append("Retrying", cons::ConsoleColor(cons::ConsoleColor::color::yellow,
+		cons::ConsoleColor::color::black));
+	 @endcode
+
+	 @param top_        The first row of the band
+	 @param rows_       The height of the band, or Screen::ALL_ROWS for
+	                    every row from 'top_' down
+	 @param ring_       The most recent lines, oldest first from
+	                    'next_ - count_'
+	 @param next_       Where the next line goes in 'ring_'
+	 @param count_      The number of lines in 'ring_'
+	 @param generation_ The terminal size generation the band was last
+	                    painted for
+	*/
+	class LogPane
+	{
+	public:
+		static constexpr size_t DEFAULT_HISTORY = 256;
+
+		/**
+		 Reserves the band and clears it
+
+		 @param history The number of lines kept for repainting
+		*/
+		LogPane(unsigned top, unsigned rows = Screen::ALL_ROWS, size_t history = DEFAULT_HISTORY);
+		LogPane(const LogPane&) = delete;
+		LogPane& operator=(const LogPane&) = delete;
+
+		/**
+		 Gives the band back to the terminal's screen, which repaints in
+		 full
+		*/
+		~LogPane();
+
+		void append(std::string_view line);
+		void append(std::string_view line, ConsoleColor color);
+
+		/**
+		 Redraws the band from the kept lines, the newest at the bottom
+		*/
+		void repaint();
+
+		/**
+		 @returns The number of lines kept
+		*/
+		[[nodiscard]] size_t size() const;
+
+	private:
+		struct line
+		{
+			std::string text;
+			ConsoleColor color;
+			bool colored;
+		};
+
+		unsigned top_;
+		unsigned rows_;
+
+		mutable std::mutex mutex_;
+		std::vector<line> ring_;
+		size_t next_ = 0;
+		size_t count_ = 0;
+		size_t generation_ = 0;
+
+		void add(std::string_view text, ConsoleColor color, bool colored);
+
+		/**
+		 @returns Whether any of the band is on the screen, with its rows
+		          and the screen's width in the other arguments
+		*/
+		bool get_area(unsigned& top, unsigned& bottom, unsigned& columns) const;
+
+		void paint_all(OutputBuffer& buf);
+
+		/**
+		 @returns The number of columns written
+		*/
+		unsigned put_line(OutputBuffer& buf, const line& l, unsigned columns) const;
+	};
+} // namespace cons
+#endif // !CONS_OUTPUT_LOG_PANE_HEADER__
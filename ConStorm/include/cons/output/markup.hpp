@@ -0,0 +1,591 @@
+/*
+ Code by Drake Johnson
+
+ Defines 'cons::markup()' and 'cons::markup_into()', which print text
+ colored with inline tags. Markup strings are wrapped in the CONS_MARKUP
+ macro so that the tags are parsed, and their escape sequences built, at
+ compile time; at runtime, only copies of constant text and sequences (and
+ the formatted arguments) remain.
+
+ The markup syntax:
+   [color]     : Sets the text color, where 'color' is the name of any
+                 ConsoleColor::color value (e.g. 'red', 'bright_blue')
+   [on_color]  : Sets the background color
+   [b]         : Makes the text bold (intense on the Windows console)
+   [/]         : Closes the most recent tag, restoring the colors before it
+   [[          : A literal '['
+   {...}       : A replacement field, exactly as in CONS_FMT format strings
+ Tags left open at the end of the string are closed automatically.
+
+ Header includes:
+   - format.hpp    : CONS_FMT format string parsing
+     - formatter.hpp : formatter, format_to()
+   - console.hpp   : ConsoleColor
+   - <array>       : array
+   - <cstdint>     : uint64_t
+   - <string_view> : string_view
+   - <tuple>       : tuple, get
+   - <utility>     : index_sequence
+*/
+#ifndef CONS_OUTPUT_MARKUP_HEADER__
+#define CONS_OUTPUT_MARKUP_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include "format.hpp"
+#include <cons/utilities/console.hpp>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace cons
+{
+	namespace detail
+	{
+		/**
+		 Base of every type created by CONS_MARKUP
+		*/
+		struct markup_string_tag {};
+	} // namespace detail
+} // namespace cons
+
+/**
+ Wraps a string literal so it can be used as compile-time markup.
+
+ Example usage:
+ @code
+	 cons::print(cons::markup(CONS_MARKUP("[red]ERROR[/] disk [b]full[/]")));
+	 cons::print(cons::markup(CONS_MARKUP("[bright_green]{}[/] of {} passed"), 9, 10));
+ @endcode
+*/
+#define CONS_MARKUP(str)                                                    \
+	([] {                                                                   \
+		struct cons_markup_string_ : ::cons::detail::markup_string_tag      \
+		{                                                                   \
+			static constexpr ::std::string_view value() { return str; }     \
+		};                                                                  \
+		return cons_markup_string_{};                                       \
+	}())
+
+namespace cons
+{
+	namespace detail
+	{
+		constexpr unsigned char MARKUP_DEFAULT_COLOR = 16;
+		constexpr size_t MARKUP_MAX_DEPTH = 16;
+		constexpr size_t MARKUP_MAX_SGR = 16;
+
+		/**
+		 The colors in effect at some point of a markup string. A color of
+		 MARKUP_DEFAULT_COLOR is the terminal's default.
+		*/
+		struct markup_style
+		{
+			static constexpr std::uint64_t MARKUP_ID_BIT = std::uint64_t{ 1 } << 63;
+			static constexpr unsigned BOLD_ID = 17U * 17U; // Above every color pair
+
+			unsigned char fg = MARKUP_DEFAULT_COLOR;
+			unsigned char bg = MARKUP_DEFAULT_COLOR;
+			bool bold = false;
+
+			[[nodiscard]] constexpr bool is_default() const noexcept
+			{
+				return fg == MARKUP_DEFAULT_COLOR && bg == MARKUP_DEFAULT_COLOR && !bold;
+			}
+
+			/**
+			 @returns The value which identifies this style to
+			          'OutputBuffer::set_attributes()'. Bit 63 is set, so
+			          these never equal the values used for ConsoleColor
+			          objects.
+			*/
+			[[nodiscard]] constexpr std::uint64_t get_attribute_id() const noexcept
+			{
+				return MARKUP_ID_BIT | (fg + 17U * bg + (bold ? BOLD_ID : 0U));
+			}
+
+			/**
+			 @returns Whether `attributes`, as given to
+			          'OutputBuffer::set_attributes()', are a markup style
+			          with bold on
+			*/
+			[[nodiscard]] static constexpr bool is_bold(const std::uint64_t attributes) noexcept
+			{
+				return (attributes & MARKUP_ID_BIT) != 0 && (attributes & ~MARKUP_ID_BIT) >= BOLD_ID;
+			}
+
+			[[nodiscard]] constexpr bool operator==(const markup_style& other) const noexcept
+			{
+				return fg == other.fg && bg == other.bg && bold == other.bold;
+			}
+		};
+
+		/**
+		 A change of style at position `pos` of the markup's text, with the
+		 escape sequence which applies the whole style
+		*/
+		struct markup_change
+		{
+			size_t pos = 0;
+			markup_style style;
+			char sgr[MARKUP_MAX_SGR] = {};
+			size_t sgr_size = 0;
+
+			[[nodiscard]] constexpr std::string_view get_sequence() const noexcept
+			{
+				return std::string_view(sgr, sgr_size);
+			}
+		};
+
+		/**
+		 Sizes of the pieces of a parsed markup string
+		*/
+		struct markup_counts
+		{
+			size_t text_size;
+			size_t change_count;
+		};
+
+		/**
+		 Strips the tags out of a markup string, recording a style change
+		 wherever the colors change. When `text` and `changes` are nullptr,
+		 only counts.
+		*/
+		class markup_parser
+		{
+		public:
+			constexpr markup_parser(const std::string_view str, char* text,
+				markup_change* changes)
+				: str_(str), text_(text), changes_(changes)
+			{}
+
+			constexpr markup_counts run()
+			{
+				markup_style stack[MARKUP_MAX_DEPTH] = {};
+				size_t depth = 0;
+				markup_style current;
+				size_t pos = 0;
+
+				while (pos < str_.size())
+				{
+					const auto ch = str_[pos];
+					if (ch != '[')
+					{
+						put(ch);
+						++pos;
+						continue;
+					}
+
+					if (pos + 1 < str_.size() && str_[pos + 1] == '[')
+					{ // Escaped bracket
+						put('[');
+						pos += 2;
+						continue;
+					}
+
+					const auto close = str_.find(']', pos + 1);
+					if (close == std::string_view::npos)
+						throw FormatStringException("unterminated markup tag");
+
+					const auto tag = str_.substr(pos + 1, close - pos - 1);
+					if (tag == "/")
+					{
+						if (depth == 0)
+							throw FormatStringException("'[/]' without an open markup tag");
+						current = stack[--depth];
+					}
+					else
+					{
+						if (depth == MARKUP_MAX_DEPTH)
+							throw FormatStringException("markup tags nested too deeply");
+						stack[depth++] = current;
+						current = apply_tag(current, tag);
+					}
+
+					add_change(current);
+					pos = close + 1;
+				}
+
+				add_change(markup_style{});
+				return { text_size_, change_count_ };
+			}
+
+		private:
+			std::string_view str_;
+			char* text_;
+			markup_change* changes_;
+			size_t text_size_ = 0;
+			size_t change_count_ = 0;
+			markup_style last_style_;
+			markup_style before_last_style_;
+			size_t last_pos_ = static_cast<size_t>(-1);
+
+			constexpr void put(const char ch)
+			{
+				if (text_ != nullptr)
+					text_[text_size_] = ch;
+				++text_size_;
+			}
+
+			/**
+			 Records a change to `style` at the current end of the text. Tags
+			 with no text between them are merged into one change, and changes
+			 which leave the style as it was are dropped.
+			*/
+			constexpr void add_change(const markup_style& style)
+			{
+				if (change_count_ > 0 && last_pos_ == text_size_)
+				{ // Replaces the change at the same position
+					if (style == before_last_style_)
+					{
+						--change_count_;
+						last_style_ = before_last_style_;
+						last_pos_ = static_cast<size_t>(-1);
+						return;
+					}
+
+					last_style_ = style;
+					write_change(change_count_ - 1, style);
+					return;
+				}
+
+				if (style == last_style_)
+					return;
+
+				before_last_style_ = last_style_;
+				last_style_ = style;
+				last_pos_ = text_size_;
+				write_change(change_count_++, style);
+			}
+
+			constexpr void write_change(const size_t index, const markup_style& style)
+			{
+				if (changes_ == nullptr)
+					return;
+
+				auto& change = changes_[index];
+				change.pos = text_size_;
+				change.style = style;
+				change.sgr_size = 0;
+
+				const auto put_sgr = [&change](const char ch) { change.sgr[change.sgr_size++] = ch; };
+				const auto put_code = [&put_sgr](const unsigned code)
+				{
+					if (code >= 100)
+						put_sgr(static_cast<char>('0' + code / 100));
+					if (code >= 10)
+						put_sgr(static_cast<char>('0' + code / 10 % 10));
+					put_sgr(static_cast<char>('0' + code % 10));
+				};
+
+				put_sgr('\x1b');
+				put_sgr('[');
+				put_code(style.bold ? 1 : 22);
+				put_sgr(';');
+				put_code(color_code(style.fg, 30, 90, 39));
+				put_sgr(';');
+				put_code(color_code(style.bg, 40, 100, 49));
+				put_sgr('m');
+			}
+
+			[[nodiscard]] static constexpr unsigned color_code(const unsigned char color,
+				const unsigned base, const unsigned bright_base, const unsigned default_code)
+			{
+				if (color == MARKUP_DEFAULT_COLOR)
+					return default_code;
+				return ((color & ConsoleColor::INTENSITY_BIT) ? bright_base : base)
+					+ ConsoleColor::get_ansi_color_number(color);
+			}
+
+			[[nodiscard]] static constexpr markup_style apply_tag(markup_style style,
+				std::string_view tag)
+			{
+				if (tag == "b")
+				{
+					style.bold = true;
+					return style;
+				}
+
+				const auto background = tag.substr(0, 3) == "on_";
+				if (background)
+					tag.remove_prefix(3);
+
+				const auto color = color_value(tag);
+				if (background)
+					style.bg = color;
+				else
+					style.fg = color;
+				return style;
+			}
+
+			[[nodiscard]] static constexpr unsigned char color_value(const std::string_view name)
+			{
+				using value_type = std::underlying_type_t<ConsoleColor::color>;
+				constexpr std::pair<std::string_view, value_type> colors[] = {
+					{ "black",         static_cast<value_type>(ConsoleColor::color::black) },
+					{ "blue",          static_cast<value_type>(ConsoleColor::color::blue) },
+					{ "green",         static_cast<value_type>(ConsoleColor::color::green) },
+					{ "aqua",          static_cast<value_type>(ConsoleColor::color::aqua) },
+					{ "red",           static_cast<value_type>(ConsoleColor::color::red) },
+					{ "purple",        static_cast<value_type>(ConsoleColor::color::purple) },
+					{ "yellow",        static_cast<value_type>(ConsoleColor::color::yellow) },
+					{ "white",         static_cast<value_type>(ConsoleColor::color::white) },
+					{ "gray",          static_cast<value_type>(ConsoleColor::color::gray) },
+					{ "bright_blue",   static_cast<value_type>(ConsoleColor::color::bright_blue) },
+					{ "bright_green",  static_cast<value_type>(ConsoleColor::color::bright_green) },
+					{ "bright_aqua",   static_cast<value_type>(ConsoleColor::color::bright_aqua) },
+					{ "bright_red",    static_cast<value_type>(ConsoleColor::color::bright_red) },
+					{ "bright_purple", static_cast<value_type>(ConsoleColor::color::purple)
+						| ConsoleColor::INTENSITY_BIT },
+					{ "bright_yellow", static_cast<value_type>(ConsoleColor::color::bright_yellow) },
+					{ "bright_white",  static_cast<value_type>(ConsoleColor::color::bright_white) }
+				};
+
+				for (const auto& color : colors)
+				{
+					if (color.first == name)
+						return static_cast<unsigned char>(color.second);
+				}
+				throw FormatStringException("unknown markup tag");
+			}
+		};
+
+		template <class MarkupStr>
+		/**
+		 Holds the text and style changes of a CONS_MARKUP string
+		*/
+		struct markup_parsed
+		{
+			static_assert(std::is_base_of_v<markup_string_tag, MarkupStr>,
+				"Markup strings must be wrapped in CONS_MARKUP()");
+
+			static constexpr markup_counts counts =
+				markup_parser(MarkupStr::value(), nullptr, nullptr).run();
+
+			struct parts
+			{
+				std::array<char, counts.text_size> text{};
+				std::array<markup_change, counts.change_count> changes{};
+			};
+
+			static constexpr parts parse()
+			{
+				parts result{};
+				markup_parser(MarkupStr::value(), result.text.data(),
+					result.changes.data()).run();
+				return result;
+			}
+
+			static constexpr parts value = parse();
+		};
+
+		template <class MarkupStr>
+		/**
+		 The text of a markup string, with its tags removed, as a CONS_FMT
+		 format string
+		*/
+		struct markup_format : format_string_tag
+		{
+			static constexpr std::string_view value()
+			{
+				return std::string_view(markup_parsed<MarkupStr>::value.text.data(),
+					markup_parsed<MarkupStr>::counts.text_size);
+			}
+		};
+
+		enum class markup_op_kind
+		{
+			literal,
+			arg,
+			style
+		};
+
+		/**
+		 One step of printing a markup string: copy literal text, format an
+		 argument (`index` is its format segment), or apply a style (`index`
+		 is its change)
+		*/
+		struct markup_op
+		{
+			markup_op_kind kind = markup_op_kind::literal;
+			size_t begin = 0;
+			size_t size = 0;
+			size_t index = 0;
+		};
+
+		template <size_t SegCount, size_t ChangeCount>
+		/**
+		 Merges the format segments of a markup string's text with its style
+		 changes, splitting literal text where the style changes. When `ops`
+		 is nullptr, only counts.
+		*/
+		constexpr size_t markup_build_ops(const std::array<fmt_segment, SegCount>& segs,
+			const std::array<markup_change, ChangeCount>& changes, markup_op* ops)
+		{
+			size_t count = 0;
+			size_t next_change = 0;
+			const auto add = [&count, ops](const markup_op& op)
+			{
+				if (ops != nullptr)
+					ops[count] = op;
+				++count;
+			};
+			const auto add_changes_before = [&](const size_t end)
+			{
+				while (next_change < ChangeCount && changes[next_change].pos <= end)
+					add({ markup_op_kind::style, 0, 0, next_change++ });
+			};
+
+			for (size_t i = 0; i < SegCount; ++i)
+			{
+				const auto& seg = segs[i];
+				if (seg.arg != FMT_NO_ARG)
+				{
+					add_changes_before(seg.lit_begin);
+					add({ markup_op_kind::arg, 0, 0, i });
+					continue;
+				}
+
+				auto pos = seg.lit_begin;
+				const auto end = seg.lit_begin + seg.lit_size;
+				while (next_change < ChangeCount && changes[next_change].pos < end)
+				{
+					const auto change_pos = changes[next_change].pos;
+					if (change_pos > pos)
+					{
+						add({ markup_op_kind::literal, pos, change_pos - pos, 0 });
+						pos = change_pos;
+					}
+					add({ markup_op_kind::style, 0, 0, next_change++ });
+				}
+				if (pos < end)
+					add({ markup_op_kind::literal, pos, end - pos, 0 });
+			}
+
+			add_changes_before(static_cast<size_t>(-1));
+			return count;
+		}
+
+		template <class MarkupStr>
+		/**
+		 Holds the print steps of a CONS_MARKUP string
+		*/
+		struct markup_ops
+		{
+			using segments = fmt_segments<markup_format<MarkupStr>>;
+
+			static constexpr size_t size = markup_build_ops(segments::value,
+				markup_parsed<MarkupStr>::value.changes, nullptr);
+
+			static constexpr std::array<markup_op, size> build()
+			{
+				std::array<markup_op, size> ops{};
+				markup_build_ops(segments::value,
+					markup_parsed<MarkupStr>::value.changes, ops.data());
+				return ops;
+			}
+
+			static constexpr std::array<markup_op, size> value = build();
+		};
+
+		/**
+		 Applies the style of `change` to the output in `buf`. On ANSI
+		 terminals, appends its escape sequence unless it is already in
+		 effect; on the Windows console, flushes and sets the console's text
+		 attributes.
+		*/
+		void markup_apply_style(OutputBuffer& buf, const markup_change& change);
+
+		template <class MarkupStr, size_t Index, class Tuple>
+		void markup_write_op(OutputBuffer& buf, const Tuple& args)
+		{
+			constexpr auto& op = markup_ops<MarkupStr>::value[Index];
+
+			if constexpr (op.kind == markup_op_kind::literal)
+				buf.append(markup_format<MarkupStr>::value().substr(op.begin, op.size));
+			else if constexpr (op.kind == markup_op_kind::arg)
+			{
+				constexpr auto& seg = markup_ops<MarkupStr>::segments::value[op.index];
+				fmt_write_arg(buf, std::get<seg.arg>(args), seg);
+			}
+			else
+				markup_apply_style(buf, markup_parsed<MarkupStr>::value.changes[op.index]);
+		}
+
+		template <class MarkupStr, class Tuple, size_t... Indices>
+		void markup_write_all(OutputBuffer& buf, const Tuple& args,
+			std::index_sequence<Indices...>)
+		{
+			(markup_write_op<MarkupStr, Indices>(buf, args), ...);
+		}
+	} // namespace detail
+
+	template <class MarkupStr, class... Args>
+	/**
+	 Appends the markup string to `buf` in color, with `args` filling its
+	 replacement fields. The markup and its fields are checked against the
+	 argument types at compile time.
+
+	 @param buf  The OutputBuffer to append to
+	 @param args The arguments referred to by the markup's replacement fields
+	*/
+	void markup_into(OutputBuffer& buf, MarkupStr, const Args&... args)
+	{
+		using ops = detail::markup_ops<MarkupStr>;
+		static_assert(detail::check_format<Args...>(ops::segments::value),
+			"Invalid markup string");
+
+		detail::markup_write_all<MarkupStr>(buf, std::forward_as_tuple(args...),
+			std::make_index_sequence<ops::size>{});
+	}
+
+	template <class MarkupStr, class... Args>
+	/**
+	 A line of markup which has not been written yet. Holds references to its
+	 arguments, so it must be printed before they go out of scope. Created by
+	 'cons::markup()' and printable through cons::print() and cons::prompt().
+
+	 @param args_ References to the arguments to format
+	*/
+	class marked_up
+	{
+	public:
+		explicit marked_up(const Args&... args) : args_(args...) {}
+
+		void write(OutputBuffer& buf) const
+		{
+			std::apply([&buf](const Args&... args)
+			{
+				markup_into(buf, MarkupStr{}, args...);
+			}, args_);
+		}
+
+	private:
+		std::tuple<const Args&...> args_;
+	};
+
+	template <class MarkupStr, class... Args>
+	struct formatter<marked_up<MarkupStr, Args...>>
+	{
+		static void format(OutputBuffer& buf, const marked_up<MarkupStr, Args...>& value)
+		{
+			value.write(buf);
+		}
+	};
+
+	template <class MarkupStr, class... Args>
+	/**
+	 Creates a line of markup for use as an argument to cons::print() or
+	 cons::prompt()
+
+	 @param args The arguments referred to by the markup's replacement fields
+	 @returns An object which writes the markup when printed
+	*/
+	[[nodiscard]] marked_up<MarkupStr, Args...> markup(MarkupStr, const Args&... args)
+	{
+		return marked_up<MarkupStr, Args...>(args...);
+	}
+} // namespace cons
+#endif // !CONS_OUTPUT_MARKUP_HEADER__
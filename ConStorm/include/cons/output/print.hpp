@@ -2,11 +2,14 @@
  Code by Drake Johnson
 
  This header defines the print function. This function abstracts away direct 
- calls to the 'println' classes. 
+ calls to the 'println' classes. Every call to 'print' is gathered into the
+ calling thread's OutputBuffer and handed to an OutputSink with one call.
 
  Included in this header:
    - println.hpp : <iostream> : cout, flush
-   - <type_traits>            : std::forward 
+     - formatter.hpp : format_to()
+       - buffer.hpp : OutputFrame
+         - sink.hpp : OutputSink
 */
 #ifndef CONS_PRINT_HEADER__
 #define CONS_PRINT_HEADER__
@@ -14,32 +17,57 @@
 #	pragma once
 #endif //_MSC_VER
 #include "println.hpp"
-#include <type_traits>
 
 namespace cons
 {
+	namespace detail
+	{
+		template <typename... LnTy>
+		/**
+		 Formats every line into `buf` in one flat pass, each followed by a
+		 newline
+		*/
+		void print_lines(OutputBuffer& buf, const LnTy&... lines)
+		{
+			((format_to(buf, lines), buf.append('\n')), ...);
+		}
+	} // namespace detail
+
 	/**
 	 Empty overload for 'print' function that flushes the stream
 	*/
-	inline void print() { std::cout << std::flush; }
+	inline void print() { OutputFrame::flush(); }
 
 	template <typename LnTy, typename... OtherLnTy>
 	/**
 	 A wrapper function for calling the 'println' and displaying
-	 one printable object per line.
+	 one printable object per line. All of the lines are formatted into one
+	 buffer before being written to the console. Types with a 'formatter'
+	 skip 'println' and are appended to the buffer directly. Lines are taken
+	 by forwarding reference, so neither lvalues nor temporaries are copied.
 
-	 @param line   The current line to be sent to 'println'
-	 @param others The lines to be recursively sent back through the function
+	 @param line   The first line to print
+	 @param others The lines printed after `line`, in order
 	*/
-	void print(LnTy line, OtherLnTy... others)
+	void print(LnTy&& line, OtherLnTy&&... others)
 	{
-		{ // `p` will be deleted when exiting this scope to save memory
-			println<LnTy> p(line);
-		}
-		std::cout << '\n';
+		OutputFrame frame;
+		detail::print_lines(out(), line, others...);
+	}
 
-		// Print `others` recursively
-		print(std::forward<OtherLnTy>(others)...);
+	template <typename LnTy, typename... OtherLnTy>
+	/**
+	 Identical to 'print', except the lines are written to `sink` instead of
+	 the sink returned by 'get_output_sink()'
+
+	 @param sink   The OutputSink to write the lines to
+	 @param line   The first line to print
+	 @param others The lines printed after `line`, in order
+	*/
+	void print_to(OutputSink& sink, LnTy&& line, OtherLnTy&&... others)
+	{
+		OutputFrame frame(sink);
+		detail::print_lines(out(), line, others...);
 	}
 } // namespace cons 
 #endif // !CONS_PRINT_HEADER__
@@ -5,27 +5,36 @@
 
  Headers included:
    - master.hpp
+     - buffer.hpp : OutputBuffer, OutputFrame, out()
      - <iostream> : cout
 
-   - deque.hpp
+   - range.hpp
      - master.hpp
+     - <iterator> : begin, end
+
+   - deque.hpp
+     - range.hpp
      - <deque>
 
    - set.hpp
-     - master.hpp
+     - range.hpp
      - <set>           : set
      - <unordered_set> : unordered_set
 
    - vector.hpp
-     - master.hpp
+     - range.hpp
      - <vector> : vector
 
+   - styled_text.hpp
+     - formatter.hpp : formatter
+     - <vector>      : vector
+
    - textf.hpp
      - master.hpp
        - <iostream> : cout
      - <exception>   : exception
      - <string_view> : string_view
-     - <Windows.h>
+     - <Windows.h> (Windows only)
 
    - word_wrap.hpp
      - <string>        : string
@@ -37,9 +46,11 @@
 #define CONS_PRINTLN_HEADER__
 
 #include "println/master.hpp"
+#include "println/range.hpp"
 #include "println/deque.hpp"
 #include "println/set.hpp"
 #include "println/vector.hpp"
+#include "println/styled_text.hpp"
 #include "println/textf.hpp"
 #include "word_wrap.hpp"
 
@@ -4,19 +4,22 @@
  The println class defines the behavior of all printable objects
  and which objects are printable.
 
- The following STL headers are included:
-   - <iostream> : cout
+ The following headers are included:
+   - output/formatter.hpp : formatter, has_formatter_v
+     - output/buffer.hpp  : out()
+   - <iostream>           : cout
 */
 #ifndef CONS_PRINTLN_MASTER_HEADER__
 #define CONS_PRINTLN_MASTER_HEADER__
 #ifdef _MSC_VER
 #	pragma once
 #endif //_MSC_VER
+#include "../formatter.hpp"
 #include <iostream>
 
 namespace cons
 {
-	template <class LnTy, class = void>
+	template <class LnTy, class>
 	/**
 	 Classes are used due to the current limitations that are function
 	 partial template specialization. To overcome this, 'println' is
@@ -27,6 +30,9 @@ namespace cons
 	       use functions like cons::print() or cons::prompt() to
 		   call println correctly.
 
+	 Types with a 'formatter' are appended straight to the output buffer;
+	 every other type is inserted through an std::ostream.
+
 	 Example usage:
 	 @code
 		 cons::println p1("Test 1");
@@ -38,9 +44,14 @@ namespace cons
 	class println
 	{
 	public:
-		println(LnTy line)
+		println(const LnTy& line)
 		{
-			std::cout << line;
+			using value_type = std::remove_cv_t<std::remove_reference_t<LnTy>>;
+
+			if constexpr (has_formatter_v<value_type>)
+				formatter<value_type>::format(out(), line);
+			else
+				out().stream() << line;
 		}
 	};
 
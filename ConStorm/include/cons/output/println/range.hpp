@@ -0,0 +1,141 @@
+/*
+ Code by Drake Johnson
+
+ Provides a 'formatter' specialization for every range: any type whose
+ objects can be passed to std::begin() and std::end(). This covers all of the
+ STL containers, arrays, and views. The range is never copied; its elements
+ are formatted in place, one per line.
+
+ The following headers are included:
+   - master.hpp    : println
+     - formatter.hpp : formatter, format_to()
+   - <iterator>    : begin, end
+   - <string_view> : string_view
+   - <type_traits> : enable_if_t, void_t
+   - <utility>     : declval, pair
+*/
+#ifndef CONS_PRINTLN_RANGE_HEADER__
+#define CONS_PRINTLN_RANGE_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif //_MSC_VER
+#include "master.hpp"
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace cons
+{
+	namespace detail
+	{
+		template <class Ty, class = void>
+		struct is_range : std::false_type {};
+
+		template <class Ty>
+		struct is_range<Ty, std::void_t<
+			decltype(std::begin(std::declval<const Ty&>())),
+			decltype(std::end(std::declval<const Ty&>()))>>
+			: std::true_type {};
+	} // namespace detail
+
+	template <class Ty>
+	/**
+	 'true' if 'Ty' is printed as a range of lines. Strings are ranges of
+	 characters, but are printed as a single line instead.
+	*/
+	inline constexpr bool is_printable_range_v = detail::is_range<Ty>::value &&
+		!std::is_convertible_v<const Ty&, std::string_view>;
+
+	template <class ItTy>
+	/**
+	 A range made from a pair of iterators, for printing part of a container
+	 without copying it. Created by 'cons::make_range()'.
+
+	 @param first_ Iterator to the first element
+	 @param last_  Iterator one past the last element
+	*/
+	class iterator_range
+	{
+	public:
+		iterator_range(ItTy first, ItTy last) : first_(first), last_(last) {}
+
+		[[nodiscard]] ItTy begin() const { return first_; }
+		[[nodiscard]] ItTy end() const { return last_; }
+
+	private:
+		ItTy first_;
+		ItTy last_;
+	};
+
+	template <class ItTy>
+	/**
+	 Example usage:
+	 @code
+		 std::vector<int> nums{ 1, 2, 3, 4, 5 };
+		 cons::print(cons::make_range(nums.begin() + 1, nums.end() - 1));
+	 @endcode
+
+	 @param first Iterator to the first element
+	 @param last  Iterator one past the last element
+	 @returns A printable range over [`first`, `last`)
+	*/
+	[[nodiscard]] iterator_range<ItTy> make_range(ItTy first, ItTy last)
+	{
+		return iterator_range<ItTy>(first, last);
+	}
+
+	template <class FirstTy, class SecondTy>
+	/**
+	 Formatter for std::pair, which is also the element type of the STL map
+	 containers. Printed as "first: second".
+	*/
+	struct formatter<std::pair<FirstTy, SecondTy>>
+	{
+		static void format(OutputBuffer& buf, const std::pair<FirstTy, SecondTy>& pair)
+		{
+			format_to(buf, pair.first);
+			buf.append(": ");
+			format_to(buf, pair.second);
+		}
+	};
+
+	template <class Ty>
+	/**
+	 Formatter for ranges. One element is printed per line. For this to
+	 compile, the element type must be printable. The last element does not
+	 have a newline character appended to it.
+
+	 Example usage:
+	 @code
+		 std::vector<double> doubs
+		 {
+			 1.03485,
+			 44.281 ,
+			 55.0   ,
+			 198.53
+		 };
+		 cons::print(doubs);
+
+		 std::map<std::string, int> ages{ { "Ann", 31 }, { "Bob", 27 } };
+		 cons::print(ages);
+	 @endcode
+	*/
+	struct formatter<Ty, std::enable_if_t<is_printable_range_v<Ty>>>
+	{
+		static void format(OutputBuffer& buf, const Ty& lines)
+		{
+			auto first = true;
+			for (const auto& line : lines)
+			{
+				// Newline before all except the first element
+				if (!first)
+					buf.append('\n');
+				first = false;
+
+				format_to(buf, line);
+			}
+		}
+	};
+} // namespace cons
+#endif // !CONS_PRINTLN_RANGE_HEADER__
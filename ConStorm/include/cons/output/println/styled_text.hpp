@@ -0,0 +1,116 @@
+/*
+ Code by Drake Johnson
+
+ Defines the StyledText class, a line of text where different parts may have
+ different colors, and a formatter which prints it in one pass.
+
+ Header includes:
+   - formatter.hpp : formatter, OutputBuffer
+   - console.hpp   : ConsoleColor
+   - <cstdint>     : uint32_t
+   - <string>      : string
+   - <string_view> : string_view
+   - <vector>      : vector
+*/
+#ifndef CONS_PRINTLN_STYLED_TEXT_HEADER__
+#define CONS_PRINTLN_STYLED_TEXT_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include "../formatter.hpp"
+#include <cons/utilities/console.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cons
+{
+	/**
+	 Holds one string of text and a list of runs, each of which colors a range
+	 of that text. Text not covered by a run is printed in the terminal's
+	 default colors. Appending text in the same color as the run before it
+	 extends that run, so the list holds the fewest runs possible.
+
+	 Unlike a series of 'textf' objects, a StyledText is printed by one
+	 formatter pass over a single buffer, and changes color only where the
+	 color actually changes.
+
+	 Example usage:
+	 @code
+		 using color = cons::ConsoleColor::color;
+
+		 cons::StyledText line;
+		 line.append("Status: ");
+		 line.append("OK", cons::ConsoleColor(color::bright_green, color::black));
+		 line.append(" (3 warnings)", cons::ConsoleColor(color::yellow, color::black));
+		 cons::print(line);
+	 @endcode
+
+	 @param text_ The text, in every color
+	 @param runs_ The colored ranges of `text_`, in order and not overlapping
+	*/
+	class StyledText
+	{
+	public:
+		/**
+		 A range of the text printed in one color
+		*/
+		struct run
+		{
+			std::uint32_t offset;
+			std::uint32_t length;
+			ConsoleColor color;
+		};
+
+		StyledText() = default;
+		explicit StyledText(std::string text);
+		StyledText(std::string text, ConsoleColor color);
+
+		/**
+		 Appends text in the terminal's default colors
+		*/
+		StyledText& append(std::string_view text);
+		StyledText& append(size_t count, char ch);
+
+		/**
+		 Appends text in `color`
+		*/
+		StyledText& append(std::string_view text, ConsoleColor color);
+		StyledText& append(size_t count, char ch, ConsoleColor color);
+
+		/**
+		 Appends the text of `other`, keeping its colors
+		*/
+		StyledText& append(const StyledText& other);
+
+		void clear() noexcept;
+
+		[[nodiscard]] const std::string& get_text() const noexcept { return text_; }
+		[[nodiscard]] const std::vector<run>& get_runs() const noexcept { return runs_; }
+		[[nodiscard]] size_t size() const noexcept { return text_.size(); }
+		[[nodiscard]] bool empty() const noexcept { return text_.empty(); }
+
+	private:
+		std::string text_;
+		std::vector<run> runs_;
+
+		/**
+		 Colors `length` characters of `text_` starting at `offset`, extending
+		 the last run instead when it ends at `offset` in the same color
+		*/
+		void add_run(size_t offset, size_t length, ConsoleColor color);
+	};
+
+	template <>
+	/**
+	 Template specialization for the cons::formatter struct. This allows for
+	 printing a cons::StyledText object via the cons::print() or
+	 cons::prompt() functions, and through 'println<StyledText>'.
+	*/
+	struct formatter<StyledText>
+	{
+		static void format(OutputBuffer& buf, const StyledText& text);
+	};
+} // namespace cons
+#endif // !CONS_PRINTLN_STYLED_TEXT_HEADER__
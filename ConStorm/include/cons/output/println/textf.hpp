@@ -10,11 +10,9 @@
 	 - <iostream> : cout
    - <exception>   : exception
    - <string_view> : string_view
-   - <windows.h>   : CONSOLE_SCREEN_BUFFER_INFO, COORD, HANDLE, WORD
 */
 #ifndef CONS_PRINTLN_COLORED_TEXT_HEADER__
 #define CONS_PRINTLN_COLORED_TEXT_HEADER__
-#ifdef _WIN32
 #include "master.hpp"
 #include <cons/utilities/console.hpp>
 #include <string_view>
@@ -23,7 +21,9 @@ namespace cons
 {
 	/**
 	 Holds the information for formatted text. Currently, only a different 
-	 color is supported.
+	 color is supported. The color is set by the console backend (see
+	 backend.hpp): through the console API on Windows, and with ANSI escape
+	 sequences written with the rest of the output everywhere else.
 
 	 A 'textf' object can be initialized with either no arguments or with text.
 	 The color, by default, is a bright white foreground on a black background. 
@@ -92,6 +92,11 @@ namespace cons
 
 		virtual void display() const;
 
+		/**
+		 Appends the colored text to `buf` instead of the console's buffer.
+		 Used when a textf is formatted (see 'formatter').
+		*/
+		virtual void display(OutputBuffer& buf) const;
 
 		/**
 		 Modifies the color of the specified layer. For example, if the 
@@ -126,8 +131,8 @@ namespace cons
 		 @param color The color to set the specified layer to
 		*/
 		void set_color(ConsoleColor color);
-		void set_foreground_color(ConsoleColor::color color);
-		void set_background_color(ConsoleColor::color color);
+		void set_foreground_color(ConsoleColor::value color);
+		void set_background_color(ConsoleColor::value color);
 
 		[[nodiscard]] std::string get_text() const;
 		[[nodiscard]] ConsoleColor get_color() const;
@@ -138,20 +143,28 @@ namespace cons
 		std::string text_;
 		ConsoleColor color_;
 
-		static WORD get_win_color(ConsoleColor color);
-
 		/**
 		 Splits up the task of displaying the message. This is the setup phase 
 		 and can be overridden.
 
-		 @returns The old console attributes to save color information
+		 @param buf The buffer the text is about to be appended to
+		*/
+		virtual void setup_console(OutputBuffer& buf) const;
+
+		/**
+		 Returns to the default colors after the text. With ANSI, the reset
+		 is held back until the next uncolored output, or until the buffer
+		 is flushed.
+
+		 @param buf The buffer the text was appended to
 		*/
-		[[nodiscard]] virtual WORD setup_console() const;
+		virtual void restore_console(OutputBuffer& buf) const;
 
 		/**
-		 Restores the old console attributes after displaying
+		 Called by every setter after the text or the color changes, so a
+		 derived class can drop what it built from them
 		*/
-		virtual void restore_console(WORD old_attribs) const;
+		virtual void on_change() noexcept {}
 
 		static void copy(textf& dest, const textf& src);
 		static void move(textf& dest, textf&& src) noexcept;
@@ -171,6 +184,18 @@ namespace cons
 		}
 	};
 
+	template <class Ty>
+	/**
+	 Formatter for 'textf' objects, and for every class derived from it
+	*/
+	struct formatter<Ty, std::enable_if_t<std::is_base_of_v<textf, Ty>>>
+	{
+		static void format(OutputBuffer& buf, const textf& text)
+		{
+			text.display(buf);
+		}
+	};
+
 	/**
 	 Exception struct for invalid layer enum values
 	*/
@@ -180,5 +205,4 @@ namespace cons
 		InvalidConsoleLayerEnumValueException();
 	};
 } // namespace cons
-#endif // _WIN32
 #endif // !CONS_PRINTLN_COLORED_TEXT_HEADER__
@@ -9,8 +9,6 @@
      - println/master.hpp : println
      - println/set.hpp
      - println/vector.hpp
-
-   - <type_traits> : forward, move
 */
 #ifndef CONS_PROMPT_HEADER__
 #define CONS_PROMPT_HEADER__
@@ -18,10 +16,14 @@
 #	pragma once
 #endif //_MSC_VER
 #include "println.hpp"
-#include <type_traits>
 
 namespace cons
 {
+    /**
+     The message shown by 'prompt()' when it is called without one
+    */
+    constexpr const char* DEFAULT_PROMPT = "Enter: ";
+
     template <typename PrTy = const char*>
     /**
      A wrapper function for calling 'println' and displaying only
@@ -31,12 +33,29 @@ namespace cons
      This function may be called with no parameters for the default
      message "Enter: " to be displayed.
 
+     The prompt is written to the console when the function returns, unless
+     an outer OutputFrame is still open.
+
+     @param prompt The prompt message to display to the user
+    */
+    void prompt(PrTy&& prompt = DEFAULT_PROMPT)
+    {
+        OutputFrame frame;
+        format_to(out(), prompt);
+    }
+
+    template <typename PrTy = const char*>
+    /**
+     Identical to 'prompt', except the prompt is written to `sink` instead of
+     the sink returned by 'get_output_sink()'
+
+     @param sink   The OutputSink to write the prompt to
      @param prompt The prompt message to display to the user
     */
-    void prompt(PrTy prompt = "Enter: ")
+    void prompt_to(OutputSink& sink, PrTy&& prompt = DEFAULT_PROMPT)
     {
-        println<PrTy> p(std::forward<PrTy>(prompt));
-        std::cout << std::flush;
+        OutputFrame frame(sink);
+        format_to(out(), prompt);
     }
 
 } // namespace cons
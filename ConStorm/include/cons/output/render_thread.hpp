@@ -0,0 +1,162 @@
+/*
+ Code by Drake Johnson
+
+ Contains the RenderThread class, a thread which owns the terminal and
+ paints the newest frame published by the program, so that drawing never
+ waits on terminal output
+
+ Header includes:
+   - screen.hpp             : Screen, ScreenFrame
+   - <atomic>               : atomic
+   - <chrono>               : steady_clock
+   - <condition_variable>   : condition_variable
+   - <cstdint>              : uint64_t
+   - <mutex>                : mutex
+   - <thread>               : thread
+*/
+#ifndef CONS_OUTPUT_RENDER_THREAD_HEADER__
+#define CONS_OUTPUT_RENDER_THREAD_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include "screen.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace cons
+{
+	/**
+	 Paints frames on a thread of its own. While one exists, presenting the
+	 terminal's screen (see 'Screen::get()') only copies the frame into a
+	 triple buffer and returns; the render thread takes the newest frame,
+	 presents it with a Screen of its own, and writes it to the output sink.
+
+	 The triple buffer has one slot for the publishing thread to fill, one
+	 for the render thread to paint, and one in between. Publishing swaps
+	 the filled slot with the middle one in a single atomic exchange, so a
+	 frame the render thread has not taken yet is replaced, not queued:
+	 the render thread only ever paints the newest frame, and frames
+	 published faster than the paint rate are skipped. Neither side waits
+	 for the other, except to wake the render thread when it is idle.
+
+	 Frames are published by one thread at a time. Call 'flush()' (which
+	 'cons::flush_async()' and input do) before anything that depends on
+	 the frame being on the terminal.
+
+	 Only one RenderThread is used by the terminal's screen; others may
+	 still be published to directly. It should be destroyed on the thread
+	 which draws, since the terminal's screen is repainted in full
+	 afterwards.
+
+	 Example usage:
+	 @code
+	 cons::RenderThread renderer(30); // At most 30 paints per second
+	 cons::menu_loop(&main_menu);     // Menus are painted by the renderer
+	 @endcode
+
+	 @param interval_     The shortest time between two paints
+	 @param slots_        The triple buffer
+	 @param back_         The slot the publishing thread fills
+	 @param middle_       The slot between the two threads, and FRESH if it
+	                      holds a frame which has not been painted
+	 @param front_        The slot the render thread paints
+	 @param invalid_from_ The lowest row invalidated by any published
+	                      frame since the last paint
+	 @param published_    The number of frames published
+	 @param painted_      The sequence number of the last frame painted
+	 @param screen_       What the render thread has painted
+	*/
+	class RenderThread
+	{
+	public:
+		static constexpr unsigned DEFAULT_MAX_RATE = 60;
+
+		/**
+		 Starts the render thread
+
+		 @param max_rate The most frames painted per second, or 0 for no
+		                 limit
+		*/
+		explicit RenderThread(unsigned max_rate = DEFAULT_MAX_RATE);
+		RenderThread(const RenderThread&) = delete;
+		RenderThread& operator=(const RenderThread&) = delete;
+
+		/**
+		 Paints the newest frame, if it has not been, and stops the thread
+		*/
+		~RenderThread();
+
+		/**
+		 @returns The render thread the terminal's screen publishes to, or
+		          null if there is none
+		*/
+		[[nodiscard]] static RenderThread* get_active() noexcept;
+
+		/**
+		 Copies the frame drawn into `screen` and hands it to the render
+		 thread. Does not wait for the frame to be painted.
+		*/
+		void publish(Screen& screen);
+
+		/**
+		 Blocks until every frame published before this call has been
+		 painted or skipped, and the paint has been written to the sink.
+		 The paint rate limit does not apply to it.
+		*/
+		void flush();
+
+		[[nodiscard]] std::uint64_t get_published() const noexcept { return published_.load(); }
+		[[nodiscard]] std::uint64_t get_painted() const noexcept { return paints_.load(); }
+
+		/**
+		 @returns The number of frames replaced by a newer one before they
+		          were painted
+		*/
+		[[nodiscard]] std::uint64_t get_skipped() const noexcept { return skipped_.load(); }
+
+	private:
+		static constexpr unsigned INDEX = 3;
+		static constexpr unsigned FRESH = 4;
+
+		std::chrono::steady_clock::duration interval_;
+
+		struct slot
+		{
+			ScreenFrame frame;
+			std::uint64_t sequence = 0; // The order it was published in, from 1
+		};
+
+		slot slots_[3];
+		unsigned back_ = 0;
+		std::atomic<unsigned> middle_{ 1 };
+		unsigned front_ = 2;
+
+		std::atomic<unsigned> invalid_from_{ ~0U };
+		std::atomic<std::uint64_t> published_{ 0 };
+		std::atomic<std::uint64_t> painted_{ 0 };
+		std::atomic<std::uint64_t> paints_{ 0 };
+		std::atomic<std::uint64_t> skipped_{ 0 };
+		std::atomic<bool> sleeping_{ false };
+		std::atomic<bool> urgent_{ false };
+		bool stop_ = false;
+
+		Screen screen_;
+
+		std::mutex mutex_;
+		std::condition_variable work_cv_;
+		std::condition_variable progress_cv_;
+
+		std::thread renderer_;
+
+		[[nodiscard]] bool has_frame() const noexcept { return (middle_.load() & FRESH) != 0; }
+		void wake_renderer();
+
+		void run();
+		void paint();
+	};
+} // namespace cons
+#endif // !CONS_OUTPUT_RENDER_THREAD_HEADER__
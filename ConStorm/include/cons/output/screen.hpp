@@ -0,0 +1,286 @@
+/*
+ Code by Drake Johnson
+
+ Contains the Screen class, a grid of character cells which is drawn into
+ and then written to the terminal by sending only the cells that changed
+ since the last frame
+
+ Header includes:
+   - encoder.hpp   : screen_cell, UpdateEncoder
+   - header.hpp    : Header
+   - word_wrap.hpp : WordWrap, StyledText
+   - <cstdint>     : uint32_t, uint64_t
+   - <string_view>   : string_view
+   - <unordered_map> : unordered_map
+   - <vector>        : vector
+*/
+#ifndef CONS_OUTPUT_SCREEN_HEADER__
+#define CONS_OUTPUT_SCREEN_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include "encoder.hpp"
+#include "header.hpp"
+#include "word_wrap.hpp"
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cons
+{
+	/**
+	 A drawn frame, copied out of a Screen so that it can be presented by
+	 another one (see RenderThread)
+
+	 @param colors     The colors of the styles the cells refer to, by style
+	                   index. Index 0 is the default colors.
+	 @param valid_rows The rows the terminal was known to show when the
+	                   frame was copied
+	*/
+	struct ScreenFrame
+	{
+		unsigned columns = 0;
+		unsigned rows = 0;
+		unsigned used_rows = 0;
+		unsigned cursor_x = 0;
+		unsigned cursor_y = 0;
+		unsigned valid_rows = 0;
+		unsigned reserved_top = 0;
+		unsigned reserved_end = 0;
+		std::vector<screen_cell> cells;
+		std::vector<ConsoleColor> colors;
+	};
+
+	/**
+	 A framebuffer the size of the terminal. Each frame is drawn into the
+	 back buffer, starting with 'begin_frame()', and 'present()' compares it
+	 with the front buffer (what the terminal shows) and writes only the
+	 cells which differ, wrapped in the synchronized output markers so that
+	 terminals which support them show the frame all at once. The cursor
+	 moves, repeated characters, and erased row ends are chosen by the
+	 UpdateEncoder, by their cost in bytes.
+
+	 The terminal's contents are only known while nothing else writes to
+	 it. Output printed to the console by anything other than the screen is
+	 noticed (by the number of bytes written to the output sink) and makes
+	 the next frame a full repaint; output sent to other sinks is not.
+	 Input echoed by the terminal is not output, so it must be reported
+	 with 'invalidate_after_input()'.
+
+	 A frame taller than the terminal, or one presented when the output is
+	 not styled (see TerminalInfo), is written line by line and scrolls
+	 like ordinary printed text. Sinks which keep a transcript (see
+	 'OutputSink::keeps_transcript()') are written every frame that way,
+	 without colors.
+
+	 Each cell holds one UTF-8 character, assumed to be one column wide.
+	 A Screen is not thread-safe.
+
+	 Example usage:
+	 @code
+	 auto& screen = cons::Screen::get();
+	 screen.begin_frame();
+	 auto row = screen.draw(0, cons::Header("Title"));
+	 const auto end = screen.write(0, row + 1, "Enter: ");
+	 screen.set_cursor(end, row + 1);
+	 screen.present(); // Only the changes since the last frame are written
+	 @endcode
+
+	 @param columns_     The width of the screen
+	 @param rows_        The height of the screen
+	 @param used_rows_   The rows drawn in the current frame, which may be
+	                     more than 'rows_'
+	 @param valid_rows_  The rows of the front buffer known to match the
+	                     terminal; rows past it are cleared before drawing
+	 @param cursor_x_    The column the cursor is left in after 'present()'
+	 @param cursor_y_    The row the cursor is left in after 'present()'
+	 @param shown_cursor_x_, shown_cursor_y_
+	                     Where the last presented frame left the cursor
+	 @param reserved_top_, reserved_end_
+	                     The rows left to be drawn by something else. The end
+	                     may be past the bottom row.
+	 @param output_mark_ The output byte count after the last 'present()'
+	 @param generation_  The terminal size generation the screen was sized
+	                     for, if it follows the terminal
+	 @param front_       The cells the terminal shows
+	 @param back_        The cells of the frame being drawn
+	 @param styles_      The colors the cells refer to. Index 0 is the
+	                     default colors. Once it holds more than
+	                     'MAX_STYLES', it is rebuilt from the styles the
+	                     front buffer uses at the start of the next frame.
+	 @param style_ids_   The index of each style in 'styles_' but the
+	                     default, by attribute id
+	 @param remapped_styles_
+	                     This screen's style for each of an imported frame's
+	*/
+	class Screen
+	{
+	public:
+		static constexpr unsigned ALL_ROWS = ~0U;
+
+		/**
+		 Creates a screen of a fixed size, which does not follow the terminal
+		*/
+		Screen(unsigned columns, unsigned rows);
+
+		/**
+		 @returns The screen for the terminal, which is resized to match it
+		          at the start of each frame
+		*/
+		[[nodiscard]] static Screen& get();
+
+		/**
+		 Starts a new frame with a blank back buffer and the cursor at the
+		 top left
+		*/
+		void begin_frame();
+
+		/**
+		 Writes text into the back buffer, starting at column `x` of row `y`.
+		 Text past the right edge is cut off, and control characters are
+		 written as spaces.
+
+		 @returns The column after the last cell written
+		*/
+		unsigned write(unsigned x, unsigned y, std::string_view text);
+		unsigned write(unsigned x, unsigned y, std::string_view text, ConsoleColor color);
+		unsigned write(unsigned x, unsigned y, const StyledText& text);
+
+		/**
+		 Draws a header and its underline in the header's colors, at the
+		 header's column if it has one
+
+		 @returns The row after the underline
+		*/
+		unsigned draw(unsigned row, const Header& header);
+
+		/**
+		 Draws each wrapped line on its own row
+
+		 @returns The row after the last line
+		*/
+		unsigned draw(unsigned row, const WordWrap& text);
+
+		/**
+		 Sets where the cursor is left after the frame is presented
+		*/
+		void set_cursor(unsigned x, unsigned y) noexcept;
+
+		/**
+		 Writes the frame to the calling thread's OutputBuffer: only the
+		 changed cells when the terminal's contents are known, otherwise
+		 the whole frame. While a RenderThread is running, the terminal's
+		 screen publishes the frame to it instead.
+		*/
+		void present();
+
+		/**
+		 Forgets what the terminal shows, so the next frame clears the
+		 screen and is drawn in full
+		*/
+		void invalidate() noexcept;
+
+		/**
+		 Reports that the terminal moved the cursor down `lines` lines from
+		 where the frame left it, such as by echoing input and the Enter
+		 key. The rows from the cursor down are repainted, or the whole
+		 screen if the terminal may have scrolled.
+		*/
+		void invalidate_after_input(unsigned lines = 1) noexcept;
+
+		void resize(unsigned columns, unsigned rows);
+
+		/**
+		 Leaves `count` rows, from row `top` down, to be drawn by something
+		 else, such as a LogPane. The screen never writes to or clears them,
+		 so they keep their contents across frames and repaints. A count of
+		 'ALL_ROWS' reserves every row from `top` down; 0 releases them.
+		*/
+		void reserve_rows(unsigned top, unsigned count) noexcept;
+
+		/**
+		 Copies the frame drawn since 'begin_frame()' into `frame`, which is
+		 then responsible for presenting it. The screen assumes the terminal
+		 is kept up to date, and forgets any invalidation.
+		*/
+		void export_frame(ScreenFrame& frame);
+
+		/**
+		 Replaces the frame being drawn with `frame`, sizing the screen to
+		 match it. Rows past the frame's 'valid_rows' are repainted by the
+		 next 'present()'.
+		*/
+		void import_frame(const ScreenFrame& frame);
+
+		[[nodiscard]] unsigned get_columns() const noexcept { return columns_; }
+		[[nodiscard]] unsigned get_rows() const noexcept { return rows_; }
+
+	private:
+		struct style
+		{
+			std::uint64_t attributes;
+			ConsoleColor color;
+		};
+
+		static constexpr size_t MAX_STYLES = 256;
+		static constexpr screen_cell BLANK{ ' ', 0 };
+		static constexpr screen_cell UNKNOWN{ 0, 0 }; // Differs from every drawn cell
+
+		unsigned columns_;
+		unsigned rows_;
+		unsigned used_rows_ = 0;
+		unsigned valid_rows_ = 0;
+		unsigned cursor_x_ = 0;
+		unsigned cursor_y_ = 0;
+		unsigned shown_cursor_x_ = 0;
+		unsigned shown_cursor_y_ = 0;
+		unsigned reserved_top_ = 0;
+		unsigned reserved_end_ = 0;
+		size_t output_mark_ = 0;
+		size_t generation_ = 0;
+		bool follows_terminal_ = false;
+		std::vector<screen_cell> front_;
+		std::vector<screen_cell> back_;
+		std::vector<style> styles_;
+		std::unordered_map<std::uint64_t, std::uint32_t> style_ids_;
+		std::vector<std::uint32_t> remapped_styles_;
+
+		std::uint32_t get_style(ConsoleColor color);
+
+		/**
+		 Drops the styles the front buffer does not use, once there are
+		 more than 'MAX_STYLES'. The back buffer must not hold any.
+		*/
+		void compact_styles();
+		unsigned write_cells(unsigned x, unsigned y, std::string_view text, std::uint32_t style);
+
+		void present_changes(OutputBuffer& buf);
+		void present_lines(OutputBuffer& buf, bool styled);
+
+		/**
+		 Writes the frame as lines, without the colors unless `styled`
+		*/
+		void write_lines(OutputBuffer& buf, bool styled) const;
+
+		/**
+		 @returns Whether more cells changed than clearing the screen and
+		          drawing the frame from scratch would write
+		*/
+		[[nodiscard]] bool is_repaint_shorter() const;
+
+		[[nodiscard]] bool is_reserved(const unsigned row) const noexcept
+		{
+			return row >= reserved_top_ && row < reserved_end_;
+		}
+		void put_cell(OutputBuffer& buf, screen_cell c, std::uint32_t& current_style) const;
+		void apply_style(OutputBuffer& buf, std::uint32_t style, std::uint32_t& current_style) const;
+
+		/**
+		 @returns The number of bytes written and waiting to be written,
+		          which changes if anything else is printed
+		*/
+		[[nodiscard]] static size_t get_output_position();
+	};
+} // namespace cons
+#endif // !CONS_OUTPUT_SCREEN_HEADER__
@@ -0,0 +1,230 @@
+/*
+ Code by Drake Johnson
+
+ Defines the 'OutputSink' interface and its basic implementations. An
+ OutputSink is the final destination of everything printed by the library:
+ when an OutputFrame is flushed, its buffered bytes are handed to a sink in
+ one call.
+
+ Header includes:
+   - <cstddef>          : size_t
+   - <initializer_list> : initializer_list
+   - <string>           : string
+   - <string_view>      : string_view
+   - <vector>           : vector
+*/
+#ifndef CONS_OUTPUT_SINK_HEADER__
+#define CONS_OUTPUT_SINK_HEADER__
+#ifdef _MSC_VER
+#	pragma once
+#endif // _MSC_VER
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cons
+{
+	/**
+	 The interface for every destination of printed output. Implement this
+	 interface to send output somewhere none of the sinks below can.
+	*/
+	class OutputSink
+	{
+	public:
+		virtual ~OutputSink() = default;
+
+		/**
+		 Delivers one block of formatted output. Called once per flushed
+		 OutputFrame, never once per line.
+
+		 @param data Pointer to the first byte to write
+		 @param size The number of bytes to write
+		*/
+		virtual void write(const char* data, size_t size) = 0;
+
+		/**
+		 Delivers one block of output which holds frames presented by a
+		 Screen. `terminal` draws them with the cursor movement that updates
+		 a terminal; `transcript` is the same output with each frame written
+		 in full as plain lines. Writes `transcript` if 'keeps_transcript()',
+		 otherwise `terminal`.
+		*/
+		virtual void write_frames(std::string_view terminal, std::string_view transcript)
+		{
+			const auto text = keeps_transcript() ? transcript : terminal;
+			write(text.data(), text.size());
+		}
+
+		/**
+		 Blocks until everything previously passed to 'write()' has reached
+		 its final destination. Does nothing by default.
+		*/
+		virtual void flush() {}
+
+		/**
+		 @returns Whether this sink keeps a record of the output, such as a
+		          file, rather than showing it on a terminal. A Screen's frames
+		          are then written to it in full as plain lines. False by
+		          default.
+		*/
+		[[nodiscard]] virtual bool keeps_transcript() const { return false; }
+
+	protected:
+		OutputSink()                                 = default;
+		OutputSink(const OutputSink&)                = default;
+		OutputSink(OutputSink&&) noexcept            = default;
+		OutputSink& operator=(const OutputSink&)     = default;
+		OutputSink& operator=(OutputSink&&) noexcept = default;
+	};
+
+	/**
+	 Writes to the process' standard output. Anything still waiting in
+	 std::cout is flushed first so that output stays in order.
+	*/
+	class StdoutSink final : public OutputSink
+	{
+	public:
+		void write(const char* data, size_t size) override;
+	};
+
+	/**
+	 Writes to an already open file descriptor. The descriptor is not closed
+	 by this object.
+
+	 @param fd_ The file descriptor to write to
+	*/
+	class FdSink final : public OutputSink
+	{
+	public:
+		explicit FdSink(int fd) noexcept : fd_(fd) {}
+
+		void write(const char* data, size_t size) override;
+
+		[[nodiscard]] int get_fd() const noexcept { return fd_; }
+
+	private:
+		int fd_;
+	};
+
+	/**
+	 Appends everything written to a growable in-memory buffer. Useful for
+	 rendering menus without a terminal. Memory is only allocated when the
+	 buffer outgrows its capacity; 'clear()' keeps the capacity.
+
+	 Example usage:
+	 @code
+	 cons::MemorySink mem;
+	 cons::print_to(mem, "Line 1", "Line 2");
+	 assert(mem.str() == "Line 1\nLine 2\n");
+	 @endcode
+
+	 @param data_ Everything written to this sink since the last 'clear()'
+	*/
+	class MemorySink final : public OutputSink
+	{
+	public:
+		explicit MemorySink(size_t capacity = 4096);
+
+		void write(const char* data, size_t size) override;
+
+		[[nodiscard]] std::string_view str() const noexcept { return data_; }
+		[[nodiscard]] size_t size() const noexcept { return data_.size(); }
+
+		void reserve(size_t capacity) { data_.reserve(capacity); }
+		void clear() noexcept { data_.clear(); }
+
+	private:
+		std::string data_;
+	};
+
+	/**
+	 Discards everything written to it, keeping only a count of the bytes and
+	 writes it has received
+
+	 @param bytes_  Total bytes received
+	 @param writes_ Total calls to 'write()' received
+	*/
+	class NullSink final : public OutputSink
+	{
+	public:
+		void write(const char* data, size_t size) override;
+
+		[[nodiscard]] size_t get_bytes() const noexcept { return bytes_; }
+		[[nodiscard]] size_t get_writes() const noexcept { return writes_; }
+
+		void reset() noexcept { bytes_ = 0; writes_ = 0; }
+
+	private:
+		size_t bytes_ = 0;
+		size_t writes_ = 0;
+	};
+
+	/**
+	 Delivers the same bytes to several sinks. Output is formatted once by the
+	 OutputFrame; each additional destination only costs the write into that
+	 sink. Sinks are written to in the order they were added and must outlive
+	 this object.
+
+	 Menus are drawn by a Screen, which writes a terminal only the cells that
+	 changed, with cursor movement between them. Sinks which keep a
+	 transcript, such as a FileSink, are written each frame in full as plain
+	 lines instead, while the other sinks get the terminal's update. An
+	 AsyncSink passes on only the terminal's update, so to keep a transcript
+	 of asynchronous output, tee the FileSink with the AsyncSink rather than
+	 putting the TeeSink behind it.
+
+	 Example usage:
+	 @code
+	 cons::File audit("audit.log", cons::fopenmode::output_keep);
+	 cons::FileSink audit_sink(audit);
+	 cons::StdoutSink console;
+
+	 cons::TeeSink tee{ &console, &audit_sink };
+	 cons::set_output_sink(&tee);
+	 cons::print("Shown on the console and saved to audit.log");
+	 @endcode
+
+	 @param sinks_ The sinks every write is forwarded to
+	*/
+	class TeeSink final : public OutputSink
+	{
+	public:
+		TeeSink() = default;
+		TeeSink(std::initializer_list<OutputSink*> sinks);
+
+		void write(const char* data, size_t size) override;
+		void write_frames(std::string_view terminal, std::string_view transcript) override;
+		void flush() override;
+
+		/**
+		 @returns Whether any of the sinks keeps a transcript
+		*/
+		[[nodiscard]] bool keeps_transcript() const override;
+
+		void add_sink(OutputSink& sink);
+		void remove_sink(const OutputSink& sink);
+
+		[[nodiscard]] size_t get_sink_count() const noexcept { return sinks_.size(); }
+
+	private:
+		std::vector<OutputSink*> sinks_;
+	};
+
+	/**
+	 Sets the sink that all output is sent to when no OutputFrame on the
+	 calling thread names its own sink. The sink must outlive its use.
+
+	 @param sink The new sink, or nullptr to restore the console backend's
+	            sink (standard output, unless the memory backend is used)
+	*/
+	void set_output_sink(OutputSink* sink);
+
+	/**
+	 @returns The sink set by 'set_output_sink()', or the console backend's
+	          sink
+	*/
+	[[nodiscard]] OutputSink& get_output_sink();
+} // namespace cons
+#endif // !CONS_OUTPUT_SINK_HEADER__
@@ -8,12 +8,17 @@
  via the cons::print() or cons::prompt() functions.
 
  Header includes:
+   - println/deque.hpp       : formatter for ranges
+   - println/styled_text.hpp : StyledText
+   - <deque>         : deque
    - <string>        : string
    - <unordered_set> : unordered_set
 */
 #ifndef CONS_WORD_WRAP__
 #define CONS_WORD_WRAP__
 #include "println/deque.hpp"
+#include "println/styled_text.hpp"
+#include <deque>
 #include <string>
 #include <unordered_set>
 
@@ -23,17 +28,29 @@ namespace cons
 	 Wraps a string into lines, each with a maximum length of `line_limit_`.
 	 The lines are stored in the deque `wrapped_` with 1 line / element.
 
+	 A StyledText can be wrapped as well. Each wrapped line then keeps the
+	 colors of the text it came from, and the lines are printed in color.
+
 	 @param orig_str_      Original string to be wrapped
 	 @param char_count_    Max number of chars per line
 	 @param tab_spaces_    Number of spaces '\t' will be converted to
 	 @param processed_str_ A deque containing the wrapped version of `orig_str_`
+	 @param styled_        The wrapped lines with their colors, if a
+	                       StyledText was wrapped
 	*/
 	class WordWrap
 	{
 
 	public:
+		/**
+		 Pass as `char_count` to wrap to the terminal's width, as cached by
+		 TerminalInfo. The width is read when the text is wrapped.
+		*/
+		static constexpr unsigned TERMINAL_WIDTH = 0;
+
 		WordWrap(std::string orig_str, unsigned char_count, unsigned tab_spaces = 4);
 		WordWrap(const char* orig_str, unsigned char_count, unsigned tab_spaces = 4);
+		WordWrap(const StyledText& orig_str, unsigned char_count, unsigned tab_spaces = 4);
 		WordWrap(const WordWrap& other) = default;
 		WordWrap(WordWrap&& other) noexcept;
 		~WordWrap() = default;
@@ -45,7 +62,19 @@ namespace cons
 		WordWrap& operator=(std::string&& other) noexcept;
 
 		[[nodiscard]] std::deque<std::string> get_deque() const;
+		[[nodiscard]] const std::deque<std::string>& get_lines() const noexcept { return wrapped_; }
+
+		/**
+		 @returns The wrapped lines with their colors. Empty unless a
+		          StyledText was wrapped.
+		*/
+		[[nodiscard]] const std::deque<StyledText>& get_styled_lines() const noexcept { return styled_; }
 		[[nodiscard]] std::string get_str() const;
+
+		/**
+		 @returns The string before it was wrapped
+		*/
+		[[nodiscard]] const std::string& get_source() const noexcept { return orig_str_; }
 		[[nodiscard]] unsigned get_char_count() const { return line_limit_; }
 		[[nodiscard]] unsigned get_tab_spaces() const { return tab_spaces_; }
 		
@@ -53,24 +82,23 @@ namespace cons
 		std::string orig_str_;
 		unsigned line_limit_, tab_spaces_;
 		std::deque<std::string> wrapped_;
+		std::deque<StyledText> styled_;
 
 		void wrap();
 	};
 
 	template<>
 	/**
-	 Template specialization for the cons::println class. This allows for printing a
-	 cons::WordWrap object via the cons::print() or cons::prompt() functions.
-
-	 This functor simply calls the std::deque specialization for the cons::println
-	 class
+	 Template specialization for the cons::formatter struct. This allows for
+	 printing a cons::WordWrap object via the cons::print() or cons::prompt()
+	 functions.
 
-	 @param lines The WordWrap object to print to the console
+	 The wrapped lines are formatted in place by the range formatter; they are
+	 not copied. Lines wrapped from a StyledText are printed in color.
 	*/
-	class println<WordWrap>
+	struct formatter<WordWrap>
 	{
-	public:
-		println(const WordWrap& lines);
+		static void format(OutputBuffer& buf, const WordWrap& lines);
 	};
 } // namespace cons
 #endif // CONS_WORD_WRAP__
@@ -5,12 +5,13 @@
 */
 #ifndef CONS_UTILITIES_CONSOLE_HEADER__
 #define CONS_UTILITIES_CONSOLE_HEADER__
-#ifdef _WIN32
 
 #include "console/color.hpp"
 #include "console/exception.hpp"
 #include "console/font.hpp"
+#include "console/quantize.hpp"
+#include "console/terminal.hpp"
+#include "console/terminfo.hpp"
 #include "console/window.hpp"
 
-#endif // _WIN32
 #endif // !CONS_UTILITIES_CONSOLE_HEADER__
@@ -1,19 +1,29 @@
 /*
  Code by Drake Johnson
 
- Contains the class which simplifies the Windows console API for colors
+ Contains the class which simplifies console colors. On Windows, colors are
+ applied through the console API; everywhere else, they are written inline
+ as ANSI (SGR) escape sequences.
 */
 #ifndef CONS_UTILITIES_CONSOLE_COLOR_HEADER__
 #define CONS_UTILITIES_CONSOLE_COLOR_HEADER__
-#ifdef _WIN32
-#ifndef WIN32_LEAN_AND_MEAN
-#	define WIN32_LEAN_AND_MEAN
-#endif // !WIN32_LEAN_AND_MEAN
 #include "exception.hpp"
-#include <windows.h>
+#include <cstdint>
+#include <string_view>
+#ifdef _WIN32
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif // !WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#endif // _WIN32
 
 namespace cons
 {
+	/**
+	 Resets every attribute, including colors, to the terminal's defaults
+	*/
+	inline constexpr std::string_view ANSI_RESET = "\x1b[0m";
+
 	/**
 	 Contains the information for the default color profile of the console. This
 	 class simplifies the Windows console color API
@@ -21,43 +31,215 @@ namespace cons
 	class ConsoleColor
 	{
 	public:
+		/**
+		 Bits of a color value. These are the values of the Windows console's
+		 FOREGROUND_BLUE, FOREGROUND_GREEN, FOREGROUND_RED, and
+		 FOREGROUND_INTENSITY flags.
+		*/
+		static constexpr unsigned short BLUE_BIT = 0x1;
+		static constexpr unsigned short GREEN_BIT = 0x2;
+		static constexpr unsigned short RED_BIT = 0x4;
+		static constexpr unsigned short INTENSITY_BIT = 0x8;
+
 		/**
 		 Colors available for the `set_color()` functions (both foreground
 		 and background)
 		*/
-		enum class color : WORD
+		enum class color : unsigned short
 		{
 			black = 0,
-			blue = FOREGROUND_BLUE,
-			green = FOREGROUND_GREEN,
-			aqua = FOREGROUND_GREEN | FOREGROUND_BLUE,
-			red = FOREGROUND_RED,
-			purple = FOREGROUND_RED | FOREGROUND_BLUE,
-			yellow = FOREGROUND_RED | FOREGROUND_GREEN,
-			white = FOREGROUND_RED | FOREGROUND_BLUE | FOREGROUND_GREEN,
-			gray = FOREGROUND_INTENSITY,
-			bright_blue = FOREGROUND_BLUE | FOREGROUND_INTENSITY,
-			bright_green = FOREGROUND_GREEN | FOREGROUND_INTENSITY,
-			bright_aqua = FOREGROUND_GREEN | FOREGROUND_BLUE | FOREGROUND_INTENSITY,
-			bright_red = FOREGROUND_RED | FOREGROUND_INTENSITY,
-			bright_purple = FOREGROUND_RED | FOREGROUND_BLUE,
-			bright_yellow = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY,
-			bright_white = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE | FOREGROUND_INTENSITY
+			blue = BLUE_BIT,
+			green = GREEN_BIT,
+			aqua = GREEN_BIT | BLUE_BIT,
+			red = RED_BIT,
+			purple = RED_BIT | BLUE_BIT,
+			yellow = RED_BIT | GREEN_BIT,
+			white = RED_BIT | BLUE_BIT | GREEN_BIT,
+			gray = INTENSITY_BIT,
+			bright_blue = BLUE_BIT | INTENSITY_BIT,
+			bright_green = GREEN_BIT | INTENSITY_BIT,
+			bright_aqua = GREEN_BIT | BLUE_BIT | INTENSITY_BIT,
+			bright_red = RED_BIT | INTENSITY_BIT,
+			bright_purple = RED_BIT | BLUE_BIT,
+			bright_yellow = RED_BIT | GREEN_BIT | INTENSITY_BIT,
+			bright_white = RED_BIT | GREEN_BIT | BLUE_BIT | INTENSITY_BIT
+		};
+
+		/**
+		 How the color of one layer (foreground or background) is given
+		*/
+		enum class kind : unsigned char
+		{
+			basic,   // One of the 16 'color' values
+			indexed, // An entry of the terminal's 256-color palette
+			rgb      // A 24-bit RGB color
+		};
+
+		/**
+		 The color of one layer. Converts implicitly from a 'color' value, so
+		 the 16 basic colors can be used wherever a value is expected.
+
+		 @param bits_ The kind in bits 24-25 and the color in the low 24 bits
+		              (the 'color' value, the palette index, or 0xRRGGBB)
+		*/
+		class value
+		{
+		public:
+			constexpr value(const color basic) noexcept
+				: bits_(static_cast<std::uint32_t>(basic) & 0xF)
+			{}
+
+			/**
+			 @returns Entry `index` of the terminal's 256-color palette.
+			          Entries 0 to 15 are the basic colors in ANSI order,
+			          16 to 231 a 6x6x6 color cube, and 232 to 255 grays.
+			*/
+			[[nodiscard]] static constexpr value indexed(const unsigned char index) noexcept
+			{
+				return value(kind::indexed, index);
+			}
+
+			[[nodiscard]] static constexpr value rgb(const unsigned char red,
+				const unsigned char green, const unsigned char blue) noexcept
+			{
+				return value(kind::rgb, static_cast<std::uint32_t>(red) << 16
+					| static_cast<std::uint32_t>(green) << 8 | blue);
+			}
+
+			[[nodiscard]] constexpr kind get_kind() const noexcept
+			{
+				return static_cast<kind>(bits_ >> 24);
+			}
+
+			/**
+			 @returns The 'color' value, palette index, or 0xRRGGBB,
+			          depending on 'get_kind()'
+			*/
+			[[nodiscard]] constexpr std::uint32_t get_payload() const noexcept
+			{
+				return bits_ & 0xFFFFFF;
+			}
+
+			[[nodiscard]] constexpr std::uint32_t get_bits() const noexcept { return bits_; }
+
+			[[nodiscard]] constexpr bool operator==(const value other) const noexcept
+			{
+				return bits_ == other.bits_;
+			}
+
+			[[nodiscard]] constexpr bool operator!=(const value other) const noexcept
+			{
+				return bits_ != other.bits_;
+			}
+
+		private:
+			constexpr value(const kind k, const std::uint32_t payload) noexcept
+				: bits_(static_cast<std::uint32_t>(k) << 24 | payload)
+			{}
+
+			std::uint32_t bits_;
+		};
+
+		/**
+		 An SGR escape sequence which sets both layers of a ConsoleColor. It
+		 is held by value, so a view of it is only valid as long as the
+		 sequence itself.
+		*/
+		class ansi_sequence
+		{
+		public:
+			/**
+			 Room for two 24-bit colors, plus slack which lets the encoder
+			 copy whole table entries without checking their length
+			*/
+			static constexpr size_t CAPACITY = 48;
+
+			[[nodiscard]] std::string_view view() const noexcept
+			{
+				return std::string_view(data_, size_);
+			}
+
+		private:
+			friend class ConsoleColor;
+
+			char data_[CAPACITY];
+			unsigned char size_ = 0;
 		};
 
 		/**
 		 Sets the foreground and background colors to the console's current
-		 foreground and background colors, respectively
+		 foreground and background colors, respectively. Terminals other than
+		 the Windows console cannot be queried, so white on black is assumed.
 		*/
 		ConsoleColor();
-		explicit ConsoleColor(color foreground, color background) noexcept;
+		explicit ConsoleColor(value foreground, value background) noexcept;
 
-		void set_foreground_color(color foreground) noexcept;
-		void set_background_color(color background) noexcept;
+		void set_foreground_color(value foreground) noexcept;
+		void set_background_color(value background) noexcept;
 
+		/**
+		 @returns The layer's color, or the nearest of the 16 basic colors
+		          if it is an indexed or RGB color
+		*/
 		[[nodiscard]] color get_foreground_color() const noexcept;
 		[[nodiscard]] color get_background_color() const noexcept;
 
+		[[nodiscard]] value get_foreground() const noexcept { return foreground_; }
+		[[nodiscard]] value get_background() const noexcept { return background_; }
+
+		[[nodiscard]] bool operator==(ConsoleColor other) const noexcept;
+		[[nodiscard]] bool operator!=(ConsoleColor other) const noexcept;
+
+		/**
+		 Converts a ConsoleColor object to the ANSI escape sequence which sets
+		 its foreground and background colors. Indexed and RGB colors use the
+		 `38;5;n` and `38;2;r;g;b` forms (`48` for the background).
+		 Colors the terminal cannot display (see
+		 'TerminalInfo::get_color_depth()') are replaced by their nearest
+		 indexed or basic color first; when output is unstyled, the basic
+		 colors are used.
+
+		 The sequence is assembled from constant tables, without formatting
+		 any numbers at run time.
+		*/
+		[[nodiscard]] static ansi_sequence get_ansi_sequence(
+			ConsoleColor cons_color) noexcept;
+
+		/**
+		 Converts the bits of a color value to its ANSI color number (0 to 7,
+		 without intensity). The console API stores blue in the lowest bit,
+		 while ANSI stores red there.
+		*/
+		[[nodiscard]] static constexpr unsigned get_ansi_color_number(
+			const unsigned short bits) noexcept
+		{
+			return ((bits & RED_BIT) ? 1U : 0U)
+				| ((bits & GREEN_BIT) ? 2U : 0U)
+				| ((bits & BLUE_BIT) ? 4U : 0U);
+		}
+
+		/**
+		 @returns The nearest of the 16 basic colors to `layer`, used where
+		          only the basic colors can be displayed (e.g. the Windows
+		          console API). See 'ColorQuantizer'.
+		*/
+		[[nodiscard]] static color get_basic_color(value layer) noexcept;
+
+		/**
+		 @returns The usual appearance of `layer` as 0xRRGGBB. Basic and
+		          indexed colors depend on the terminal's theme, so this is
+		          only an approximation for them; xterm's palette is assumed.
+		*/
+		[[nodiscard]] static std::uint32_t get_rgb(value layer) noexcept;
+
+		/**
+		 @returns The nonzero value which identifies a ConsoleColor object to
+		          'OutputBuffer::set_attributes()'. Bit 63 is never set.
+		*/
+		[[nodiscard]] static std::uint64_t get_attribute_id(
+			ConsoleColor cons_color) noexcept;
+
+#ifdef _WIN32
 		/**
 		 Converts this object to a Windows console color and returns it
 
@@ -73,9 +255,10 @@ namespace cons
 		*/
 		[[nodiscard]] static ConsoleColor get_cons_console_color(
 			WORD windows_color);
+#endif // _WIN32
 
 	private:
-		color foreground_, background_;
+		value foreground_, background_;
 	};
 
 	/**
@@ -84,7 +267,7 @@ namespace cons
 	struct SetConsoleTextAttributeFailureException
 		: WindowsConsoleFailureException
 	{
-		[[nodiscard]] char const* what() const override;
+		[[nodiscard]] char const* what() const noexcept override;
 	};
 
 	/**
@@ -95,5 +278,4 @@ namespace cons
 		InvalidConsoleColorValueException();
 	};
 } // namespace cons
-#endif // _WIN32
 #endif // !CONS_UTILITIES_CONSOLE_COLOR_HEADER__
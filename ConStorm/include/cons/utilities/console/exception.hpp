@@ -7,6 +7,7 @@
 #ifndef CONS_UTILITIES_CONSOLE_EXCEPTION_HEADER__
 #define CONS_UTILITIES_CONSOLE_EXCEPTION_HEADER__
 #include <exception>
+#include <string>
 
 namespace cons
 {
@@ -15,7 +16,7 @@ namespace cons
 	*/
 	struct WindowsConsoleFailureException : std::exception
 	{
-		[[nodiscard]] const char* what() const override;
+		[[nodiscard]] const char* what() const noexcept override;
 	};
 
 	/**
@@ -24,7 +25,7 @@ namespace cons
 	struct CurrentWindowsScreenBufferFailureException
 		: WindowsConsoleFailureException
 	{
-		[[nodiscard]] char const* what() const override;
+		[[nodiscard]] char const* what() const noexcept override;
 	};
 
 	/**
@@ -34,11 +35,11 @@ namespace cons
 	struct InvalidConsoleEnumValueException : WindowsConsoleFailureException
 	{
 	private:
-		const char* enum_name_;
+		std::string message_;
 
 	public:
 		InvalidConsoleEnumValueException(const char* enum_name);
-		[[nodiscard]] const char* what() const override;
+		[[nodiscard]] const char* what() const noexcept override;
 	};
 } // namespace cons
 #endif // !CONS_UTILITIES_CONSOLE_EXCEPTION_HEADER__
@@ -1,17 +1,20 @@
 /*
  Code by Drake Johnson
 
- Contains the class which simplifies the Windows console API for fonts
+ Contains the class which simplifies the Windows console API for fonts.
+ Other terminals do not let programs change their font, so there the class
+ only stores a font.
 */
 #ifndef CONS_UTILITIES_CONSOLE_FONT_HEADER__
 #define CONS_UTILITIES_CONSOLE_FONT_HEADER__
-#ifdef _WIN32
-#ifndef WIN32_LEAN_AND_MEAN
-#	define WIN32_LEAN_AND_MEAN
-#endif // !WIN32_LEAN_AND_MEAN
 #include "exception.hpp"
 #include <string>
-#include <windows.h>
+#ifdef _WIN32
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif // !WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#endif // _WIN32
 
 namespace cons
 {
@@ -52,7 +55,7 @@ namespace cons
 		/**
 		 Font sizes available to set the console's text to
 		*/
-		enum class size : SHORT
+		enum class size : short
 		{
 			pt_10 = 10,
 			pt_12 = 12,
@@ -66,7 +69,8 @@ namespace cons
 
 		/**
 		 Default constructor stores the current console font as a ConsoleFont 
-		 object in `this`
+		 object in `this`. Outside of Windows, the font is unknown and both
+		 values are 'other'.
 		*/
 		ConsoleFont();
 		ConsoleFont(family font_family, size font_size) noexcept;
@@ -83,6 +87,7 @@ namespace cons
 		[[nodiscard]] family get_family() const;
 		[[nodiscard]] size get_size() const;
 
+#ifdef _WIN32
 		/**
 		 Converts this object to a Windows console font and returns it
 
@@ -101,6 +106,7 @@ namespace cons
 		*/
 		[[nodiscard]] static ConsoleFont get_cons_font(
 			const CONSOLE_FONT_INFOEX& font);
+#endif // _WIN32
 
 	private:
 		family family_;
@@ -117,7 +123,7 @@ namespace cons
 	struct CurrentWindowsConsoleFontFailureException
 		: WindowsConsoleFailureException
 	{
-		[[nodiscard]] char const* what() const override;
+		[[nodiscard]] char const* what() const noexcept override;
 	};
 
 	/**
@@ -138,5 +144,4 @@ namespace cons
 		InvalidConsoleFontSizeValueException();
 	};
 } // namespace cons
-#endif // _WIN32
 #endif // !CONS_UTILITIES_CONSOLE_FONT_HEADER__
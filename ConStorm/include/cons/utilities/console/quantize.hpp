@@ -0,0 +1,115 @@
+/*
+ Code by Drake Johnson
+
+ Contains the class which maps 24-bit colors to the nearest color of a
+ terminal's smaller palette
+
+ Header includes:
+   - color.hpp : ConsoleColor
+   - <array>   : array
+   - <cstddef> : size_t
+   - <cstdint> : uint32_t
+*/
+#ifndef CONS_UTILITIES_CONSOLE_QUANTIZE_HEADER__
+#define CONS_UTILITIES_CONSOLE_QUANTIZE_HEADER__
+#include "color.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace cons
+{
+	/**
+	 Maps colors to the nearest entry of a palette in constant time. Every
+	 color is looked up in a 32x32x32 cube, which holds the nearest entry to
+	 the center of each cell and is built the first time a palette is used.
+
+	 Quantizing a whole row at once can also apply an ordered (Bayer) dither,
+	 which trades the banding of smooth gradients for a fine pattern.
+
+	 Example:
+	 ```
+	 auto& quantizer = ColorQuantizer::get(ColorQuantizer::palette::xterm256);
+	 quantizer.dither_row(row.data(), row.size(), y);
+	 ```
+
+	 @param target_ The palette colors are mapped to
+	 @param spread_ How far the dither moves a channel, about one step
+	                between neighboring palette colors
+	 @param cube_   The entry for each cell: a 'color' value for 'basic16',
+	                a palette index for 'xterm256'
+	*/
+	class ColorQuantizer
+	{
+	public:
+		enum class palette
+		{
+			basic16, // The 16 'ConsoleColor::color' values
+			xterm256 // The color cube and gray ramp of the 256-color palette
+		};
+
+		static constexpr unsigned CUBE_BITS = 5;
+		static constexpr size_t CUBE_SIZE = size_t{ 1 } << (3 * CUBE_BITS);
+
+		ColorQuantizer(const ColorQuantizer&) = delete;
+		ColorQuantizer& operator=(const ColorQuantizer&) = delete;
+
+		/**
+		 @returns The quantizer for `target`, built on first use
+		*/
+		[[nodiscard]] static const ColorQuantizer& get(palette target);
+
+		/**
+		 @returns The nearest palette color to 0xRRGGBB
+		*/
+		[[nodiscard]] ConsoleColor::value quantize(std::uint32_t rgb) const noexcept
+		{
+			return make_value(cube_[get_cell(rgb)]);
+		}
+
+		/**
+		 @returns `layer` if the palette can already display it, otherwise
+		          the nearest palette color
+		*/
+		[[nodiscard]] ConsoleColor::value quantize(ConsoleColor::value layer) const noexcept;
+
+		/**
+		 Replaces every color of `colors[0, count)` with its nearest palette
+		 color
+		*/
+		void quantize_row(ConsoleColor::value* colors, size_t count) const noexcept;
+
+		/**
+		 Like 'quantize_row()', but offsets each color by a 4x4 ordered
+		 dither matrix first. `row` is the row's y coordinate, which selects
+		 the matrix row so the pattern lines up across rows. Colors the
+		 palette can already display are left unchanged.
+		*/
+		void dither_row(ConsoleColor::value* colors, size_t count,
+			size_t row) const noexcept;
+
+		[[nodiscard]] palette get_palette() const noexcept { return target_; }
+
+	private:
+		explicit ColorQuantizer(palette target);
+
+		[[nodiscard]] static size_t get_cell(const std::uint32_t rgb) noexcept
+		{
+			return (rgb >> 9 & 0x7C00) | (rgb >> 6 & 0x3E0) | (rgb >> 3 & 0x1F);
+		}
+
+		[[nodiscard]] ConsoleColor::value make_value(const unsigned char entry) const noexcept
+		{
+			return target_ == palette::basic16
+				? ConsoleColor::value(static_cast<ConsoleColor::color>(entry))
+				: ConsoleColor::value::indexed(entry);
+		}
+
+		[[nodiscard]] bool is_displayable(ConsoleColor::value layer) const noexcept;
+
+		palette target_;
+		int spread_;
+		std::array<unsigned char, CUBE_SIZE> cube_;
+	};
+} // namespace cons
+#endif // !CONS_UTILITIES_CONSOLE_QUANTIZE_HEADER__
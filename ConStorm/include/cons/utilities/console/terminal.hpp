@@ -0,0 +1,155 @@
+/*
+ Code by Drake Johnson
+
+ Contains the class which caches what is known about the terminal the
+ program writes to
+
+ Header includes:
+   - terminfo.hpp : Terminfo
+   - <atomic>     : atomic
+   - <cstddef>    : size_t
+*/
+#ifndef CONS_UTILITIES_CONSOLE_TERMINAL_HEADER__
+#define CONS_UTILITIES_CONSOLE_TERMINAL_HEADER__
+#include "terminfo.hpp"
+#include <atomic>
+#include <cstddef>
+
+namespace cons
+{
+	/**
+	 The terminal's size, whether the standard streams are terminals, its
+	 color depth, and its terminfo capabilities, queried once and then read
+	 from memory.
+
+	 Only the size can change. On POSIX systems, a SIGWINCH handler marks it
+	 stale and the next call to 'get_columns()' or 'get_rows()' queries it
+	 again; every other call is a pair of loads. The Windows console has no
+	 resize signal, so call 'invalidate()' after handling a resize event.
+
+	 Styling (colors and cursor movement) is only written when standard
+	 output is a terminal, $NO_COLOR is unset, and $TERM is not "dumb", so
+	 piped output is plain text. 'set_styled()' overrides this. The memory
+	 backend ignores the environment: it is always styled, with 24-bit
+	 color and the built-in ANSI capabilities.
+
+	 @param stdout_tty_  Whether standard output is a terminal
+	 @param stdin_tty_   Whether standard input is a terminal
+	 @param styled_      Whether escape sequences and console attributes
+	                     are written
+	 @param depth_       The colors the terminal can display
+	 @param stale_       Set when the size must be queried again
+	 @param columns_     The terminal's width
+	 @param rows_        The terminal's height
+	 @param generation_  Incremented each time a new size is read
+	*/
+	class TerminalInfo
+	{
+	public:
+		/**
+		 The colors a terminal can display
+		*/
+		enum class color_depth : unsigned char
+		{
+			none,       // No colors at all
+			basic,      // The 16 'ConsoleColor::color' values
+			indexed256, // The 256-color palette
+			truecolor   // 24-bit RGB
+		};
+
+		/**
+		 The size assumed when standard output is not a terminal
+		*/
+		static constexpr unsigned DEFAULT_COLUMNS = 80;
+		static constexpr unsigned DEFAULT_ROWS = 24;
+
+		TerminalInfo(const TerminalInfo&) = delete;
+		TerminalInfo& operator=(const TerminalInfo&) = delete;
+
+		/**
+		 @returns The instance, which queries the terminal (and installs the
+		          SIGWINCH handler) on first use
+		*/
+		[[nodiscard]] static TerminalInfo& get();
+
+		[[nodiscard]] unsigned get_columns() noexcept
+		{
+			refresh();
+			return columns_.load(std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] unsigned get_rows() noexcept
+		{
+			refresh();
+			return rows_.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 @returns A number which changes whenever the terminal is resized, so
+		          a cached layout can tell that it is out of date
+		*/
+		[[nodiscard]] size_t get_generation() noexcept
+		{
+			refresh();
+			return generation_.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 Marks the size as stale. Safe to call from a signal handler.
+		*/
+		void invalidate() noexcept { stale_.store(true, std::memory_order_relaxed); }
+
+		[[nodiscard]] bool is_stdout_tty() const noexcept { return stdout_tty_; }
+		[[nodiscard]] bool is_stdin_tty() const noexcept { return stdin_tty_; }
+
+		/**
+		 @returns Whether colors and cursor movement are written
+		*/
+		[[nodiscard]] bool is_styled() const noexcept
+		{
+			return styled_.load(std::memory_order_relaxed);
+		}
+
+		void set_styled(bool styled) noexcept { styled_.store(styled, std::memory_order_relaxed); }
+
+		/**
+		 @returns 'color_depth::none' when output is not styled, otherwise
+		          the depth from $COLORTERM or the terminfo entry
+		*/
+		[[nodiscard]] color_depth get_color_depth() const noexcept
+		{
+			return is_styled() ? depth_ : color_depth::none;
+		}
+
+		[[nodiscard]] const Terminfo& get_terminfo() const noexcept { return Terminfo::get(); }
+
+		/**
+		 @returns Whether the terminfo entry has the capability
+		*/
+		[[nodiscard]] bool has(Terminfo::string cap) const noexcept
+		{
+			return !get_terminfo().get_string(cap).empty();
+		}
+
+	private:
+		TerminalInfo();
+
+		void refresh() noexcept
+		{
+			if (stale_.load(std::memory_order_relaxed))
+				query_size();
+		}
+
+		void query_size() noexcept;
+
+		bool stdout_tty_ = false;
+		bool stdin_tty_ = false;
+		std::atomic<bool> styled_{ false };
+		color_depth depth_ = color_depth::none;
+		std::atomic<bool> stale_{ true };
+		std::atomic<unsigned> columns_{ DEFAULT_COLUMNS };
+		std::atomic<unsigned> rows_{ DEFAULT_ROWS };
+		std::atomic<size_t> generation_{ 0 };
+	};
+} // namespace cons
+#endif // !CONS_UTILITIES_CONSOLE_TERMINAL_HEADER__
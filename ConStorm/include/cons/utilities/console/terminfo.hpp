@@ -0,0 +1,154 @@
+/*
+ Code by Drake Johnson
+
+ Contains the class which reads a terminal's capabilities from its compiled
+ terminfo entry
+
+ Header includes:
+   - <initializer_list> : initializer_list
+   - <string>           : string
+   - <string_view>      : string_view
+   - <vector>           : vector
+*/
+#ifndef CONS_UTILITIES_CONSOLE_TERMINFO_HEADER__
+#define CONS_UTILITIES_CONSOLE_TERMINFO_HEADER__
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cons
+{
+	class OutputBuffer;
+
+	/**
+	 The numeric and string capabilities of a compiled terminfo entry, read
+	 directly from the terminfo database without linking against curses.
+	 Both the legacy format and the format with 32-bit numbers are read;
+	 extended (user-defined) capabilities are ignored.
+
+	 Padding (`$<...>`) is removed from strings when the entry is loaded,
+	 since nothing this library writes depends on it.
+
+	 @param name_    The entry's names, as listed in the entry
+	 @param numbers_ The numeric capabilities, -1 where absent
+	 @param strings_ The string capabilities, empty where absent
+	*/
+	class Terminfo
+	{
+	public:
+		/**
+		 Numeric capabilities, by their index in the terminfo format
+		*/
+		enum class number : unsigned short
+		{
+			columns = 0,
+			lines = 2,
+			max_colors = 13
+		};
+
+		/**
+		 String capabilities, by their index in the terminfo format
+		*/
+		enum class string : unsigned short
+		{
+			carriage_return = 2,
+			change_scroll_region = 3,
+			clear_screen = 5,
+			clr_eol = 6,
+			clr_eos = 7,
+			column_address = 8,
+			cursor_address = 10,
+			cursor_down = 11,
+			cursor_home = 12,
+			cursor_invisible = 13,
+			cursor_left = 14,
+			cursor_normal = 16,
+			cursor_right = 17,
+			cursor_up = 19,
+			exit_attribute_mode = 39,
+			parm_down_cursor = 107,
+			parm_left_cursor = 111,
+			parm_right_cursor = 112,
+			parm_up_cursor = 114,
+			repeat_char = 121,
+			row_address = 127
+		};
+
+		/**
+		 Creates an entry with no capabilities
+		*/
+		Terminfo() = default;
+
+		/**
+		 Finds and reads the entry for the terminal named `term`. The
+		 directories searched are those of $TERMINFO, ~/.terminfo,
+		 $TERMINFO_DIRS, and then the usual system locations.
+
+		 @returns The entry, or an entry with no capabilities if none was
+		          found or it could not be read
+		*/
+		[[nodiscard]] static Terminfo load(std::string_view term);
+
+		/**
+		 @returns The entry for $TERM, loaded on first use. With
+		          CONS_BACKEND_MEMORY defined, an entry with no capabilities,
+		          so the built-in ANSI defaults are used.
+		*/
+		[[nodiscard]] static const Terminfo& get();
+
+		/**
+		 @returns Whether an entry was found and read
+		*/
+		[[nodiscard]] bool is_loaded() const noexcept { return !name_.empty(); }
+
+		[[nodiscard]] const std::string& get_name() const noexcept { return name_; }
+
+		/**
+		 @returns The capability's value, or -1 if the entry lacks it
+		*/
+		[[nodiscard]] int get_number(number cap) const noexcept;
+
+		/**
+		 @returns The capability's value, or an empty view if the entry lacks
+		          it. Parameterized strings are returned as-is.
+		*/
+		[[nodiscard]] std::string_view get_string(string cap) const noexcept;
+
+		/**
+		 Expands a parameterized string capability, as curses' tparm() does.
+		 Everything but string parameters is supported: the parameters,
+		 variables, constants, arithmetic, and conditionals. The static
+		 variables (%P and %g with A to Z) are kept for each thread, so
+		 expansion is safe from any thread.
+
+		 Example usage:
+		 @code
+		 const auto& terminfo = cons::Terminfo::get();
+		 const auto move = cons::Terminfo::expand(
+		     terminfo.get_string(cons::Terminfo::string::cursor_address), { 4, 10 });
+		 @endcode
+
+		 @param cap    The capability's value
+		 @param params Up to nine numeric parameters
+		 @returns The sequence to write
+		*/
+		[[nodiscard]] static std::string expand(std::string_view cap,
+			std::initializer_list<int> params = {});
+
+		/**
+		 Like 'expand()', but appends the sequence to `buf` without building
+		 a string
+		*/
+		static void expand(OutputBuffer& buf, std::string_view cap,
+			std::initializer_list<int> params = {});
+
+	private:
+		bool parse(const std::string& data);
+
+		std::string name_;
+		std::vector<int> numbers_;
+		std::vector<std::string> strings_;
+	};
+} // namespace cons
+#endif // !CONS_UTILITIES_CONSOLE_TERMINFO_HEADER__
@@ -5,7 +5,6 @@
 */
 #ifndef CONS_UTILITIES_CONSOLE_WINDOW_HEADER__
 #define CONS_UTILITIES_CONSOLE_WINDOW_HEADER__
-#ifdef _WIN32
 #include "color.hpp"
 #include "font.hpp"
 
@@ -19,13 +18,14 @@ namespace cons
 
 		/**
 		 Sets the font and color specified by 'font_' and 'color_',
-		 respectively, to the console
+		 respectively, to the console. Outside of Windows, the color is
+		 printed as an ANSI escape sequence and the font is ignored.
 		*/
 		void apply_to_console() const;
 
 		/**
 		 Resets the console color to its color at the time of this object
-		 creation
+		 creation. Outside of Windows, resets to the terminal's default colors.
 		*/
 		void reset_color() const;
 
@@ -36,8 +36,8 @@ namespace cons
 		void reset_font() const;
 
 		void set_color(ConsoleColor color);
-		void set_foreground_color(ConsoleColor::color fg_color);
-		void set_background_color(ConsoleColor::color bg_color);
+		void set_foreground_color(ConsoleColor::value fg_color);
+		void set_background_color(ConsoleColor::value bg_color);
 
 		void set_font(ConsoleFont font);
 		void set_font_family(ConsoleFont::family family);
@@ -53,5 +53,4 @@ namespace cons
 		ConsoleColor original_color_, color_;
 	};
 } // namespace cons
-#endif // _WIN32
 #endif // !CONS_UTILITIES_CONSOLE_WINDOW_HEADER__
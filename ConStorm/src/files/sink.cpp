@@ -0,0 +1,21 @@
+/*
+ Code by Drake Johnson
+*/
+#include "../../include/cons/files/sink.hpp"
+
+namespace cons
+{
+	void FileSink::write(const char* data, const size_t size)
+	{
+		auto& ofs = file_.get_ofstream();
+		if (ofs.is_open())
+			ofs.write(data, static_cast<std::streamsize>(size));
+	}
+
+	void FileSink::flush()
+	{
+		auto& ofs = file_.get_ofstream();
+		if (ofs.is_open())
+			ofs.flush();
+	}
+} // namespace cons
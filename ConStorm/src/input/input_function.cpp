@@ -25,6 +25,7 @@ namespace cons
 				prompt(invalid_msg);
 			}
 
+			flush_before_input();
 			std::getline(std::cin, user_input);
 
 		} while (!valid_func(user_input));
@@ -27,6 +27,7 @@ namespace cons
 				else
 					prompt(invalid_msg);
 
+				flush_before_input();
 				std::getline(std::cin, user_input);
 
 			} while (valid_set.find(user_input) == valid_set.end());
@@ -9,6 +9,12 @@ namespace cons
 	void pause(const std::string& msg)
 	{
 		print(msg);
+		wait_for_key();
+	}
+
+	void wait_for_key()
+	{
+		flush_before_input();
 		std::cin.clear();
 		std::cin.ignore(std::cin.rdbuf()->in_avail() + 1);
 	}
@@ -15,6 +15,9 @@ namespace cons
 	{
 		if (!m_exit_msg.empty())
 			pause("\n " + m_exit_msg);
+
+		// Nothing may be left in an asynchronous sink when the program exits
+		flush_async();
 		return nullptr;
 	}
 } // namespace cons
\ No newline at end of file
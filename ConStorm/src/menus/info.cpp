@@ -22,22 +22,22 @@ namespace cons
 
 	InfoMenu::InfoMenu(Header title, MenuInterface* goto_next)
 		: m_title(std::move(title))
-		, m_desc("", 80, 4)
+		, m_desc("", WordWrap::TERMINAL_WIDTH, 4)
 		, m_section_headers({})
 		, m_section_texts({})
-		, m_pause_msg("Press any key to continue...")
+		, m_pause_msg(DEFAULT_PAUSE_MSG)
 		, m_goto_next(goto_next)
 	{}
 
 	InfoMenu::InfoMenu(const InfoMenu& other)
-		: m_desc("", 80, 4)
+		: m_desc("", WordWrap::TERMINAL_WIDTH, 4)
 		, m_goto_next(nullptr)
 	{
 		copy(*this, other);
 	}
 
 	InfoMenu::InfoMenu(InfoMenu&& other) noexcept
-		: m_desc("", 80, 4)
+		: m_desc("", WordWrap::TERMINAL_WIDTH, 4)
 		, m_goto_next(nullptr)
 	{
 		move(*this, std::move(other));
@@ -60,12 +60,10 @@ namespace cons
 	const MenuInterface* InfoMenu::run() const
 	{
 		display();
+		wait_for_key();
 
-		if (m_pause_msg.empty())
-			pause();
-		else
-			pause(m_pause_msg);
-
+		// The key is echoed on the row after the pause message
+		Screen::get().invalidate_after_input();
 		return m_goto_next;
 	}
 
@@ -144,19 +142,22 @@ namespace cons
 
 	void InfoMenu::display() const
 	{
-		cls();
-		print(
-			m_title,
-			m_desc,
-			"", ""
-		);
+		// Drawn into the screen, which writes only what changed since the
+		// last menu
+		auto& screen = Screen::get();
+		screen.begin_frame();
+
+		auto row = screen.draw(0, m_title);
+		row = screen.draw(row, m_desc) + 2;
 		for (size_t i = 0; i < m_section_texts.size(); ++i)
-			print(
-				m_section_headers.at(i),
-				m_section_texts.at(i),
-				""
-			);
-		print("");
+		{
+			row = screen.draw(row, m_section_headers.at(i));
+			row = screen.draw(row, m_section_texts.at(i)) + 1;
+		}
+
+		screen.write(0, ++row, m_pause_msg.empty() ? DEFAULT_PAUSE_MSG : m_pause_msg);
+		screen.set_cursor(0, row + 1);
+		screen.present();
 	}
 
 	InfoMenu::SectionPairRef InfoMenu::get_section_ref(const size_t index)
@@ -5,24 +5,25 @@
 #include <cons/menus/menu.hpp>
 #include <cons/output.hpp>
 #include <cons/input.hpp>
+#include <algorithm>
 
 namespace cons
 {
 	struct menu_options_size_mismatch_exception : std::exception
 	{
-		[[nodiscard]] const char* what() const override
+		[[nodiscard]] const char* what() const noexcept override
 		{
 			return "options_ and gotos_ must be the same size!";
 		}
 	};
 
 	Menu::Menu()
-		: desc_("", 80, 4)
+		: desc_("", WordWrap::TERMINAL_WIDTH, 4)
 	{}
 
 	Menu::Menu(Header title)
 		: title_(std::move(title))
-		, desc_("", 80, 4)
+		, desc_("", WordWrap::TERMINAL_WIDTH, 4)
 	{}
 
 	Menu::Menu(const Menu& other)
@@ -65,17 +66,21 @@ namespace cons
 			}
 		);
 
+		// The input is echoed on the prompt's row
+		Screen::get().invalidate_after_input();
 		return gotos_.at(user_input - 1);
 	}
 
 	void Menu::set_title(Header title)
 	{
 		title_ = std::move(title);
+		layout_synced_ = false;
 	}
 
 	void Menu::set_description(WordWrap desc)
 	{
 		desc_ = std::move(desc);
+		layout_synced_ = false;
 	}
 
 	void Menu::set_description(std::string desc_text)
@@ -83,12 +88,14 @@ namespace cons
 		desc_ = WordWrap(std::move(desc_text), desc_.get_char_count(),
 				desc_.get_tab_spaces()
 		);
+		layout_synced_ = false;
 	}
 
 	void Menu::set_description(std::string desc_text, 
 		const unsigned char_per_line, const unsigned spaces_for_tab)
 	{
 		desc_ = WordWrap(std::move(desc_text), char_per_line, spaces_for_tab);
+		layout_synced_ = false;
 	}
 
 	void Menu::set_prompt_msg(std::string prompt_msg)
@@ -141,26 +148,42 @@ namespace cons
 
 	void Menu::display() const
 	{
-		cls();
+		// Drawn into the screen, which writes only what changed since the
+		// last menu
+		auto& screen = Screen::get();
+		screen.begin_frame();
 
-		print(
-			title_,
-			desc_,
-			""
-		);
+		if (!layout_)
+			layout_ = std::make_unique<Layout>(make_layout());
+		if (!layout_synced_)
+		{
+			layout_->set_header(TITLE_NODE, title_);
+			layout_->set_text(DESC_NODE, desc_);
+			layout_synced_ = true;
+		}
+
+		std::string option;
+		size_t options_width = 0;
+		for (size_t i = 0; i < options_.size(); ++i)
+			options_width = std::max(options_width, Layout::get_columns(options_.at(i)) + std::to_string(i + 1).size() + 4);
+		layout_->set_slot(OPTIONS_NODE, static_cast<unsigned>(options_width),
+			static_cast<unsigned>(options_.size()));
+
+		layout_->update(screen.get_columns(), screen.get_rows());
+		layout_->draw(screen);
 
+		const auto options_area = layout_->get_content_rect(OPTIONS_NODE);
 		for (size_t i = 0; i < options_.size(); ++i)
 		{
-			std::cout
-				<< " (" << (i + 1) << ") "
-				<< options_.at(i) << '\n';
+			option.assign(" (").append(std::to_string(i + 1)).append(") ").append(options_.at(i));
+			screen.write(options_area.x, options_area.y + static_cast<unsigned>(i), option);
 		}
-		std::cout << std::endl;
 
-		if (prompt_msg_.empty())
-			prompt();
-		else
-			prompt(prompt_msg_);
+		const auto prompt_area = layout_->get_content_rect(PROMPT_NODE);
+		const auto end = screen.write(prompt_area.x, prompt_area.y,
+			prompt_msg_.empty() ? DEFAULT_PROMPT : prompt_msg_);
+		screen.set_cursor(end, prompt_area.y);
+		screen.present();
 	}
 
 	Menu::OptionPairPtr Menu::get_option_ptr(const size_t index)
@@ -180,6 +203,7 @@ namespace cons
 		dest.prompt_msg_ = src.prompt_msg_;
 		dest.options_ = src.options_;
 		dest.gotos_ = src.gotos_;
+		dest.layout_synced_ = false;
 	}
 
 	void Menu::move(Menu& dest, Menu&& src) noexcept
@@ -189,6 +213,22 @@ namespace cons
 		dest.prompt_msg_ = std::move(src.prompt_msg_);
 		dest.options_ = std::move(src.options_);
 		dest.gotos_ = std::move(src.gotos_);
+		dest.layout_ = std::move(src.layout_);
+		dest.layout_synced_ = false;
+	}
+
+	Layout Menu::make_layout()
+	{
+		// Numbered as in the header: a blank row comes before the options
+		// and before the prompt
+		Layout layout;
+		layout.add_header(Layout::ROOT, Header());
+		layout.add_text(Layout::ROOT, StyledText());
+		layout.add_slot(Layout::ROOT, 0, 0, LayoutSize::fixed(1));
+		layout.add_slot(Layout::ROOT, 0, 0);
+		layout.add_slot(Layout::ROOT, 0, 0, LayoutSize::fixed(1));
+		layout.add_slot(Layout::ROOT, 0, 1);
+		return layout;
 	}
 
 } // namespace cons
@@ -0,0 +1,294 @@
+/*
+ Code by Drake Johnson
+*/
+#include "../../include/cons/output/async_sink.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+	size_t round_up_pow2(const size_t value) noexcept
+	{
+		size_t result = 2;
+		while (result < value)
+			result <<= 1;
+		return result;
+	}
+} // namespace
+
+namespace cons
+{
+	AsyncSink::AsyncSink(OutputSink& target, const size_t capacity,
+		const AsyncOverflow policy)
+		: target_(target)
+		, policy_(policy)
+		, cell_count_(round_up_pow2((capacity + CELL_DATA - 1) / CELL_DATA))
+		, cells_(std::make_unique<cell[]>(cell_count_))
+		, writer_(&AsyncSink::run, this)
+	{}
+
+	AsyncSink::~AsyncSink()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+		}
+		work_cv_.notify_one();
+		writer_.join();
+	}
+
+	void AsyncSink::write(const char* data, const size_t size)
+	{
+		if (size == 0)
+			return;
+
+		if (finished_.load())
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			write_through(data, size);
+			return;
+		}
+
+		const auto count = (size + CELL_DATA - 1) / CELL_DATA;
+		if (count > cell_count_ || size > std::numeric_limits<std::uint32_t>::max())
+		{ // Can never fit in the ring
+			if (policy_ == AsyncOverflow::drop)
+				dropped_ += size;
+			else
+				spill(data, size);
+			return;
+		}
+
+		// Stay behind any earlier write which was spilled
+		if (spilling_.load())
+		{
+			spill(data, size);
+			return;
+		}
+
+		std::uint64_t pos = 0;
+		if (!try_claim(count, pos))
+		{
+			if (policy_ == AsyncOverflow::drop)
+			{
+				dropped_ += size;
+				return;
+			}
+			if (policy_ == AsyncOverflow::spill)
+			{
+				spill(data, size);
+				return;
+			}
+
+			// Claimed with the lock held, so the writer thread cannot stop
+			// between a failed check and the claim
+			std::unique_lock<std::mutex> lock(mutex_);
+			++waiters_;
+			while (!try_claim(count, pos))
+			{
+				if (finished_.load())
+				{
+					--waiters_;
+					write_through(data, size);
+					return;
+				}
+
+				work_cv_.notify_one();
+				progress_cv_.wait(lock, [this, count]
+				{
+					return head_.load() + count - tail_.load() <= cell_count_
+						|| finished_.load();
+				});
+			}
+			--waiters_;
+		}
+
+		publish(pos, data, size);
+	}
+
+	void AsyncSink::flush()
+	{
+		const auto pos = head_.load();
+		const auto spilled = spill_count_.load();
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		++waiters_;
+		work_cv_.notify_one();
+		progress_cv_.wait(lock, [this, pos, spilled]
+		{
+			return (delivered_.load() >= pos && spill_delivered_.load() >= spilled)
+				|| stop_;
+		});
+		--waiters_;
+	}
+
+	size_t AsyncSink::get_capacity() const noexcept
+	{
+		return cell_count_ * CELL_DATA;
+	}
+
+	bool AsyncSink::try_claim(const size_t count, std::uint64_t& pos)
+	{
+		pos = head_.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			if (pos + count - tail_.load(std::memory_order_acquire) > cell_count_)
+				return false;
+
+			if (head_.compare_exchange_weak(pos, pos + count,
+				std::memory_order_acq_rel, std::memory_order_relaxed))
+				return true;
+		}
+	}
+
+	void AsyncSink::publish(const std::uint64_t pos, const char* data,
+		const size_t size)
+	{
+		const auto mask = cell_count_ - 1;
+		for (size_t offset = 0, i = 0; offset < size; offset += CELL_DATA, ++i)
+		{
+			std::memcpy(cells_[(pos + i) & mask].data, data + offset,
+				std::min(CELL_DATA, size - offset));
+		}
+
+		// Publishing the length hands the cells to the writer thread
+		cells_[pos & mask].size.store(static_cast<std::uint32_t>(size));
+		if (sleeping_.load())
+			wake_writer();
+	}
+
+	void AsyncSink::spill(const char* data, const size_t size)
+	{
+		{
+			std::lock_guard<std::mutex> lock(spill_mutex_);
+			spill_.push_back({ head_.load(), std::string(data, size) });
+			++spill_count_;
+			spilling_.store(true);
+		}
+
+		++spilled_;
+		wake_writer();
+	}
+
+	void AsyncSink::write_through(const char* data, const size_t size)
+	{
+		target_.write(data, size);
+		target_.flush();
+	}
+
+	void AsyncSink::wake_writer()
+	{
+		{ // Pairs with the predicate check in 'run()'
+			std::lock_guard<std::mutex> lock(mutex_);
+		}
+		work_cv_.notify_one();
+	}
+
+	void AsyncSink::run()
+	{
+		std::string batch;
+		batch.reserve(get_capacity());
+		std::uint64_t tail = 0;
+
+		for (;;)
+		{
+			const auto spilled = drain(batch, tail);
+			if (waiters_.load() > 0)
+			{ // Space was freed for blocked writers
+				std::lock_guard<std::mutex> lock(mutex_);
+				progress_cv_.notify_all();
+			}
+
+			if (!batch.empty())
+			{
+				target_.write(batch.data(), batch.size());
+				target_.flush();
+				batch.clear();
+			}
+
+			delivered_.store(tail);
+			spill_delivered_ += spilled;
+			if (waiters_.load() > 0)
+			{ // Wake threads waiting in 'flush()'
+				std::lock_guard<std::mutex> lock(mutex_);
+				progress_cv_.notify_all();
+			}
+
+			std::unique_lock<std::mutex> lock(mutex_);
+			if (has_work(tail))
+				continue;
+			if (stop_ && head_.load() == tail && !spilling_.load())
+			{ // Blocked writers claim with the lock held, so they see this
+				finished_.store(true);
+				progress_cv_.notify_all();
+				break;
+			}
+
+			sleeping_.store(true);
+			work_cv_.wait(lock, [this, tail] { return stop_ || has_work(tail); });
+			sleeping_.store(false);
+		}
+	}
+
+	size_t AsyncSink::drain(std::string& batch, std::uint64_t& tail)
+	{
+		const auto mask = cell_count_ - 1;
+		const auto limit = get_capacity();
+		size_t spilled = 0;
+
+		for (;;)
+		{
+			spilled += drain_spill(batch, tail);
+
+			auto& first = cells_[tail & mask];
+			const size_t size = first.size.load();
+			if (size == 0 || batch.size() >= limit)
+				break;
+
+			const auto count = (size + CELL_DATA - 1) / CELL_DATA;
+			for (size_t offset = 0, i = 0; offset < size; offset += CELL_DATA, ++i)
+			{
+				batch.append(cells_[(tail + i) & mask].data,
+					std::min(CELL_DATA, size - offset));
+			}
+
+			// Release the cells back to the writers
+			first.size.store(0, std::memory_order_relaxed);
+			tail += count;
+			tail_.store(tail, std::memory_order_release);
+		}
+
+		return spilled;
+	}
+
+	size_t AsyncSink::drain_spill(std::string& batch, const std::uint64_t tail)
+	{
+		if (!spilling_.load())
+			return 0;
+
+		std::lock_guard<std::mutex> lock(spill_mutex_);
+		size_t count = 0;
+		while (!spill_.empty() && spill_.front().pos <= tail)
+		{
+			batch.append(spill_.front().data);
+			spill_.pop_front();
+			++count;
+		}
+
+		if (spill_.empty())
+			spilling_.store(false);
+		return count;
+	}
+
+	bool AsyncSink::has_work(const std::uint64_t tail) const
+	{
+		if (cells_[tail & (cell_count_ - 1)].size.load() != 0)
+			return true;
+		if (!spilling_.load())
+			return false;
+
+		std::lock_guard<std::mutex> lock(spill_mutex_);
+		return !spill_.empty() && spill_.front().pos <= tail;
+	}
+} // namespace cons
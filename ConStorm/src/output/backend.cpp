@@ -0,0 +1,348 @@
+/*
+ Code by Drake Johnson
+
+ Defines the parts of the console backends which are not inlined: the
+ terminal queries, which run once, and the Windows console API calls
+*/
+#include "../../include/cons/output/backend.hpp"
+#include "../../include/cons/output/clear_screen.hpp"
+#include "../../include/cons/utilities/console/terminfo.hpp"
+#include <string>
+#ifdef _WIN32
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif // !WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#else
+#	include <csignal>
+#	include <sys/ioctl.h>
+#	include <unistd.h>
+#endif // _WIN32
+
+#ifndef _WIN32
+namespace
+{
+	std::atomic<cons::backend::resize_callback> s_on_resize{ nullptr };
+	struct sigaction s_previous_winch;
+
+	/**
+	 Calls the resize callback, then passes the signal on to any handler
+	 which was installed before ours
+	*/
+	void handle_winch(const int signal)
+	{
+		if (const auto callback = s_on_resize.load())
+			callback();
+
+		if (!(s_previous_winch.sa_flags & SA_SIGINFO)
+			&& s_previous_winch.sa_handler != SIG_DFL
+			&& s_previous_winch.sa_handler != SIG_IGN)
+			s_previous_winch.sa_handler(signal);
+	}
+} // namespace
+#endif // !_WIN32
+
+namespace cons
+{
+	std::string_view backend::ansi::get_clear_sequence()
+	{
+		// Terminals without a terminfo entry are assumed to understand ANSI:
+		// home the cursor, then erase the display
+		static const std::string s_clear = []
+		{
+			const auto& terminfo = Terminfo::get();
+			const auto clear = terminfo.get_string(Terminfo::string::clear_screen);
+			if (!clear.empty())
+				return std::string(clear);
+
+			const auto home = terminfo.get_string(Terminfo::string::cursor_home);
+			const auto clear_below = terminfo.get_string(Terminfo::string::clr_eos);
+			if (!home.empty() && !clear_below.empty())
+				return std::string(home).append(clear_below);
+			return std::string("\x1b[H\x1b[2J");
+		}();
+		return s_clear;
+	}
+
+#ifdef _WIN32
+	// A Windows console which understands escape sequences is queried like
+	// any other console
+	bool backend::ansi::is_output_terminal() noexcept { return windows::is_output_terminal(); }
+	bool backend::ansi::is_input_terminal() noexcept { return windows::is_input_terminal(); }
+	bool backend::ansi::query_size(terminal_size& size) noexcept { return windows::query_size(size); }
+	void backend::ansi::on_resize(resize_callback) noexcept {}
+#else
+	bool backend::ansi::is_output_terminal() noexcept
+	{
+		return isatty(STDOUT_FILENO) != 0;
+	}
+
+	bool backend::ansi::is_input_terminal() noexcept
+	{
+		return isatty(STDIN_FILENO) != 0;
+	}
+
+	bool backend::ansi::query_size(terminal_size& size) noexcept
+	{
+		// Some ptys and CI terminals report zero rows or columns, which would
+		// make an empty Screen; the caller falls back to the default size
+		winsize window{};
+		if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &window) != 0 || window.ws_col == 0 || window.ws_row == 0)
+			return false;
+
+		size = { window.ws_col, window.ws_row };
+		return true;
+	}
+
+	void backend::ansi::on_resize(const resize_callback callback) noexcept
+	{
+		const bool installed = s_on_resize.exchange(callback) != nullptr;
+		if (installed)
+			return;
+
+		struct sigaction action {};
+		action.sa_handler = handle_winch;
+		sigemptyset(&action.sa_mask);
+		action.sa_flags = SA_RESTART;
+		sigaction(SIGWINCH, &action, &s_previous_winch);
+	}
+#endif // _WIN32
+
+#ifdef _WIN32
+	namespace
+	{
+		bool is_console(const DWORD std_handle) noexcept
+		{
+			DWORD mode;
+			return GetConsoleMode(GetStdHandle(std_handle), &mode) != 0;
+		}
+
+		/**
+		 @returns The console attributes currently in effect
+		*/
+		WORD get_console_attributes()
+		{
+			CONSOLE_SCREEN_BUFFER_INFO csbi;
+			if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi))
+				throw WindowsConsoleFailureException();
+			return csbi.wAttributes;
+		}
+
+		/**
+		 Sets the console's attributes, flushing the text written before
+		 them first. Only output headed for the console can be colored.
+		*/
+		void apply_attributes(OutputBuffer& buf, const WORD attributes)
+		{
+			if (&buf != &OutputFrame::buffer() || !TerminalInfo::get().is_styled())
+				return;
+
+			thread_local WORD current = get_console_attributes();
+			if (attributes == current)
+				return;
+
+			OutputFrame::flush();
+			if (!SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), attributes))
+				throw SetConsoleTextAttributeFailureException();
+			current = attributes;
+			detail::count_attribute_transition();
+		}
+	} // namespace
+
+	bool backend::windows::is_output_terminal() noexcept
+	{
+		return is_console(STD_OUTPUT_HANDLE);
+	}
+
+	bool backend::windows::is_input_terminal() noexcept
+	{
+		return is_console(STD_INPUT_HANDLE);
+	}
+
+	bool backend::windows::query_size(terminal_size& size) noexcept
+	{
+		CONSOLE_SCREEN_BUFFER_INFO csbi;
+		if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi))
+			return false;
+
+		size = {
+			static_cast<unsigned>(csbi.srWindow.Right - csbi.srWindow.Left + 1),
+			static_cast<unsigned>(csbi.srWindow.Bottom - csbi.srWindow.Top + 1)
+		};
+		return true;
+	}
+
+	namespace
+	{
+		/**
+		 @returns The console's attributes when the program first asked
+		*/
+		WORD get_initial_attributes() noexcept
+		{
+			static const WORD s_initial = []
+			{
+				CONSOLE_SCREEN_BUFFER_INFO csbi;
+				if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi))
+					return ConsoleColor::get_windows_console_color(
+						ConsoleColor(ConsoleColor::color::white, ConsoleColor::color::black));
+				return csbi.wAttributes;
+			}();
+			return s_initial;
+		}
+
+		/**
+		 The attributes 'reset_style()' returns to, changed by
+		 'set_default_style()'
+		*/
+		std::atomic<WORD>& get_default_attributes() noexcept
+		{
+			static std::atomic<WORD> s_default{ get_initial_attributes() };
+			return s_default;
+		}
+	} // namespace
+
+	ConsoleColor backend::windows::get_default_color() noexcept
+	{
+		return ConsoleColor::get_cons_console_color(get_default_attributes().load());
+	}
+
+	void backend::windows::clear(OutputBuffer&)
+	{
+		if (!TerminalInfo::get().is_styled())
+			return;
+
+		// The console is cleared directly, so pending output must go first
+		OutputFrame::flush();
+
+		const auto hout = GetStdHandle(STD_OUTPUT_HANDLE);
+		CONSOLE_SCREEN_BUFFER_INFO csbi;
+		if (hout == INVALID_HANDLE_VALUE || !GetConsoleScreenBufferInfo(hout, &csbi))
+			throw ClearScreenException();
+
+		const DWORD area = csbi.dwSize.X * csbi.dwSize.Y;
+		const COORD home{ 0, 0 };
+		DWORD written;
+		if (!FillConsoleOutputCharacter(hout, static_cast<TCHAR>(' '), area, home, &written)
+			|| !FillConsoleOutputAttribute(hout, csbi.wAttributes, area, home, &written))
+			throw ClearScreenException();
+
+		SetConsoleCursorPosition(hout, home);
+	}
+
+	void backend::windows::clear_below(OutputBuffer&)
+	{
+		if (!TerminalInfo::get().is_styled())
+			return;
+
+		OutputFrame::flush();
+		const auto hout = GetStdHandle(STD_OUTPUT_HANDLE);
+		CONSOLE_SCREEN_BUFFER_INFO csbi;
+		if (!GetConsoleScreenBufferInfo(hout, &csbi))
+			throw ClearScreenException();
+
+		const auto cursor = csbi.dwCursorPosition;
+		const DWORD area = csbi.dwSize.X * (csbi.dwSize.Y - cursor.Y) - cursor.X;
+		DWORD written;
+		if (!FillConsoleOutputCharacter(hout, static_cast<TCHAR>(' '), area, cursor, &written)
+			|| !FillConsoleOutputAttribute(hout, csbi.wAttributes, area, cursor, &written))
+			throw ClearScreenException();
+	}
+
+	void backend::windows::move_cursor(OutputBuffer&, const unsigned x, const unsigned y)
+	{
+		if (!TerminalInfo::get().is_styled())
+			return;
+
+		OutputFrame::flush();
+		const COORD position{ static_cast<SHORT>(x), static_cast<SHORT>(y) };
+		if (!SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), position))
+			throw WindowsConsoleFailureException();
+	}
+
+	void backend::windows::move_cursor_by(OutputBuffer& buf, const int dx, const int dy)
+	{
+		if (!TerminalInfo::get().is_styled())
+			return;
+
+		OutputFrame::flush();
+		CONSOLE_SCREEN_BUFFER_INFO csbi;
+		if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi))
+			throw WindowsConsoleFailureException();
+
+		const auto x = static_cast<int>(csbi.dwCursorPosition.X) + dx;
+		const auto y = static_cast<int>(csbi.dwCursorPosition.Y) + dy;
+		move_cursor(buf, static_cast<unsigned>(x < 0 ? 0 : x), static_cast<unsigned>(y < 0 ? 0 : y));
+	}
+
+	namespace
+	{
+		/**
+		 The position remembered by 'save_cursor()'
+		*/
+		thread_local COORD t_saved_cursor{ 0, 0 };
+	} // namespace
+
+	void backend::windows::save_cursor(OutputBuffer&)
+	{
+		if (!TerminalInfo::get().is_styled())
+			return;
+
+		OutputFrame::flush();
+		CONSOLE_SCREEN_BUFFER_INFO csbi;
+		if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi))
+			throw WindowsConsoleFailureException();
+		t_saved_cursor = csbi.dwCursorPosition;
+	}
+
+	void backend::windows::restore_cursor(OutputBuffer& buf)
+	{
+		move_cursor(buf, static_cast<unsigned>(t_saved_cursor.X),
+			static_cast<unsigned>(t_saved_cursor.Y));
+	}
+
+	void backend::windows::scroll_up(OutputBuffer&, const unsigned top, const unsigned bottom)
+	{
+		if (!TerminalInfo::get().is_styled())
+			return;
+
+		OutputFrame::flush();
+		const auto hout = GetStdHandle(STD_OUTPUT_HANDLE);
+		CONSOLE_SCREEN_BUFFER_INFO csbi;
+		if (!GetConsoleScreenBufferInfo(hout, &csbi))
+			throw WindowsConsoleFailureException();
+
+		const auto right = static_cast<SHORT>(csbi.dwSize.X - 1);
+		const SMALL_RECT moved{ 0, static_cast<SHORT>(top + 1), right, static_cast<SHORT>(bottom) };
+		const SMALL_RECT clip{ 0, static_cast<SHORT>(top), right, static_cast<SHORT>(bottom) };
+		CHAR_INFO fill;
+		fill.Char.AsciiChar = ' ';
+		fill.Attributes = get_default_attributes().load();
+		if (!ScrollConsoleScreenBuffer(hout, &moved, &clip,
+			COORD{ 0, static_cast<SHORT>(top) }, &fill))
+			throw WindowsConsoleFailureException();
+	}
+
+	void backend::windows::set_style(OutputBuffer& buf, const ConsoleColor color)
+	{
+		apply_attributes(buf, ConsoleColor::get_windows_console_color(color));
+	}
+
+	void backend::windows::reset_style(OutputBuffer& buf)
+	{
+		apply_attributes(buf, get_default_attributes().load());
+	}
+
+	void backend::windows::set_default_style(OutputBuffer& buf, const ConsoleColor color)
+	{
+		const auto attributes = ConsoleColor::get_windows_console_color(color);
+		get_default_attributes().store(attributes);
+		apply_attributes(buf, attributes);
+	}
+
+	void backend::windows::restore_default_style(OutputBuffer& buf)
+	{
+		get_default_attributes().store(get_initial_attributes());
+		apply_attributes(buf, get_initial_attributes());
+	}
+#endif // _WIN32
+} // namespace cons
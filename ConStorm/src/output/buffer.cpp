@@ -0,0 +1,313 @@
+/*
+ Code by Drake Johnson
+*/
+#include "../../include/cons/output/buffer.hpp"
+#include "../../include/cons/output/render_thread.hpp"
+#include "../../include/cons/utilities/console/color.hpp"
+#include "../../include/cons/utilities/console/terminal.hpp"
+#include <atomic>
+#include <mutex>
+
+namespace
+{
+	constexpr size_t INITIAL_CAPACITY = 4096;
+
+	std::atomic<bool> s_atomic_lines{ false };
+	std::atomic<size_t> s_attribute_transitions{ 0 };
+	std::atomic<size_t> s_bytes_written{ 0 };
+
+	/**
+	 Held only while one thread's buffer is written to its sink
+	*/
+	std::mutex& publish_mutex()
+	{
+		static std::mutex s_mutex;
+		return s_mutex;
+	}
+
+	/**
+	 Whether the calling thread has an UncountedOutput open
+	*/
+	thread_local bool t_uncounted = false;
+
+	/**
+	 The buffer 'out()' returns on the calling thread instead of its own, or
+	 nullptr
+	*/
+	thread_local cons::OutputBuffer* t_output_target = nullptr;
+
+	void write_to_sink(cons::OutputSink& sink, const cons::OutputBuffer& buf)
+	{
+		// Output redirected to another sink never reaches the console
+		if (!t_uncounted && &sink == &cons::get_output_sink())
+			s_bytes_written.fetch_add(buf.get_terminal_size(), std::memory_order_relaxed);
+
+		// Split outside the lock, like the formatting
+		thread_local std::string t_terminal;
+		thread_local std::string t_transcript;
+		if (buf.has_transcript())
+			buf.split_transcript(t_terminal, t_transcript);
+
+		std::unique_lock<std::mutex> lock(publish_mutex(), std::defer_lock);
+		if (s_atomic_lines.load(std::memory_order_relaxed))
+			lock.lock();
+
+		if (buf.has_transcript())
+			sink.write_frames(t_terminal, t_transcript);
+		else
+			sink.write(buf.data(), buf.size());
+	}
+
+	/**
+	 Owns a thread's OutputBuffer. Output still held by the flush policy when
+	 the thread exits is written to the global sink.
+	*/
+	struct thread_buffer
+	{
+		cons::OutputBuffer buf;
+
+		~thread_buffer()
+		{
+			if (!buf.empty())
+			{
+				buf.reset_attributes();
+				write_to_sink(cons::get_output_sink(), buf);
+			}
+		}
+	};
+} // namespace
+
+namespace cons
+{
+	OutputBuffer::OutputBuffer()
+		: streambuf_(*this)
+		, stream_(&streambuf_)
+	{
+		data_.reserve(INITIAL_CAPACITY);
+	}
+
+	void OutputBuffer::set_attributes(const std::uint64_t attributes,
+		const std::string_view sequence)
+	{
+		if (!TerminalInfo::get().is_styled())
+			return; // Output which is not headed for a terminal stays plain
+
+		reset_pending_ = false;
+		if (attributes == attributes_)
+			return;
+
+		data_.append(sequence.data(), sequence.size());
+		attributes_ = attributes;
+		detail::count_attribute_transition();
+	}
+
+	void OutputBuffer::reset_attributes()
+	{
+		reset_pending_ = false;
+		if (attributes_ == 0)
+			return;
+
+		data_.append(ANSI_RESET.data(), ANSI_RESET.size());
+		attributes_ = 0;
+		detail::count_attribute_transition();
+	}
+
+	void OutputBuffer::hold(held_output& held)
+	{
+		held.data.assign(data_);
+		held.attributes = attributes_;
+		held.reset_pending = reset_pending_;
+		held.frames.swap(frames_);
+		clear();
+		attributes_ = 0;
+		reset_pending_ = false;
+	}
+
+	void OutputBuffer::restore(held_output& held)
+	{
+		const auto offset = data_.size();
+		for (const auto& frame : held.frames)
+			frames_.push_back({ frame.begin + offset, frame.split + offset, frame.end + offset });
+
+		data_.append(held.data);
+		attributes_ = held.attributes;
+		reset_pending_ = held.reset_pending;
+		held.data.clear();
+		held.frames.clear();
+	}
+
+	void OutputBuffer::add_transcript_frame(const size_t begin, const size_t split)
+	{
+		frames_.push_back({ begin, split, data_.size() });
+	}
+
+	void OutputBuffer::split_transcript(std::string& terminal, std::string& transcript) const
+	{
+		terminal.clear();
+		transcript.clear();
+
+		size_t pos = 0;
+		for (const auto& frame : frames_)
+		{
+			const std::string_view shared(data_.data() + pos, frame.begin - pos);
+			terminal.append(shared).append(data_, frame.begin, frame.split - frame.begin);
+			transcript.append(shared).append(data_, frame.split, frame.end - frame.split);
+			pos = frame.end;
+		}
+		terminal.append(data_, pos, std::string::npos);
+		transcript.append(data_, pos, std::string::npos);
+	}
+
+	size_t OutputBuffer::get_terminal_size() const noexcept
+	{
+		auto size = data_.size();
+		for (const auto& frame : frames_)
+			size -= frame.end - frame.split;
+		return size;
+	}
+
+	OutputBuffer::streambuf::int_type OutputBuffer::streambuf::overflow(
+		const int_type ch)
+	{
+		if (!traits_type::eq_int_type(ch, traits_type::eof()))
+			buf_.append(traits_type::to_char_type(ch));
+		return traits_type::not_eof(ch);
+	}
+
+	std::streamsize OutputBuffer::streambuf::xsputn(const char* str,
+		const std::streamsize count)
+	{
+		buf_.append(str, static_cast<size_t>(count));
+		return count;
+	}
+
+	OutputFrame::OutputFrame() noexcept
+		: prev_sink_(nullptr)
+		, prev_depth_(0)
+		, redirect_(false)
+	{
+		++depth();
+	}
+
+	OutputFrame::OutputFrame(OutputSink& sink)
+		: prev_sink_(thread_sink())
+		, prev_depth_(depth())
+		, redirect_(true)
+	{
+		auto& buf = buffer();
+		if (!buf.empty() || buf.get_attributes() != 0)
+			buf.hold(held_);
+		thread_sink() = &sink;
+		depth() = 1;
+	}
+
+	OutputFrame::~OutputFrame()
+	{
+		const auto policy = get_flush_policy();
+		const auto outermost = --depth() == 0;
+
+		if (redirect_ || policy == FlushPolicy::immediate ||
+			(outermost && policy == FlushPolicy::on_frame))
+			flush();
+
+		if (redirect_)
+		{
+			thread_sink() = prev_sink_;
+			depth() = prev_depth_;
+			if (!held_.data.empty() || held_.attributes != 0)
+				buffer().restore(held_);
+		}
+	}
+
+	OutputBuffer& OutputFrame::buffer()
+	{
+		thread_local thread_buffer holder;
+		return holder.buf;
+	}
+
+	OutputSink& OutputFrame::sink()
+	{
+		const auto sink = thread_sink();
+		return sink != nullptr ? *sink : get_output_sink();
+	}
+
+	void OutputFrame::flush()
+	{
+		auto& buf = buffer();
+		if (buf.empty())
+			return;
+
+		buf.reset_attributes();
+		write_to_sink(sink(), buf);
+		buf.clear();
+	}
+
+	unsigned& OutputFrame::depth() noexcept
+	{
+		thread_local unsigned frame_depth = 0;
+		return frame_depth;
+	}
+
+	OutputSink*& OutputFrame::thread_sink() noexcept
+	{
+		thread_local OutputSink* frame_sink = nullptr;
+		return frame_sink;
+	}
+
+	OutputBuffer& out()
+	{
+		return t_output_target != nullptr ? *t_output_target : OutputFrame::buffer();
+	}
+
+	void flush_async()
+	{
+		OutputFrame::flush();
+		if (auto* renderer = RenderThread::get_active())
+			renderer->flush();
+		OutputFrame::sink().flush();
+	}
+
+	void set_atomic_lines(const bool enabled) noexcept
+	{
+		s_atomic_lines.store(enabled);
+	}
+
+	bool get_atomic_lines() noexcept
+	{
+		return s_atomic_lines.load();
+	}
+
+	size_t get_attribute_transitions() noexcept
+	{
+		return s_attribute_transitions.load();
+	}
+
+	size_t get_bytes_written() noexcept
+	{
+		return s_bytes_written.load();
+	}
+
+	UncountedOutput::UncountedOutput()
+	{
+		OutputFrame::flush();
+		t_uncounted = true;
+	}
+
+	UncountedOutput::~UncountedOutput()
+	{
+		OutputFrame::flush();
+		t_uncounted = false;
+	}
+
+	void detail::count_attribute_transition() noexcept
+	{
+		s_attribute_transitions.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	OutputBuffer* detail::set_output_target(OutputBuffer* const target) noexcept
+	{
+		const auto prev = t_output_target;
+		t_output_target = target;
+		return prev;
+	}
+} // namespace cons
@@ -0,0 +1,339 @@
+/*
+ Code by Drake Johnson
+
+ Defines the UpdateEncoder class
+*/
+#include <cons/output/encoder.hpp>
+#include <cons/utilities/console/terminal.hpp>
+#include <algorithm>
+
+namespace
+{
+	using cap = cons::Terminfo::string;
+
+	/**
+	 The capabilities assumed when there is no terminfo entry
+	*/
+	std::string_view get_ansi_default(const cap c) noexcept
+	{
+		switch (c)
+		{
+		case cap::carriage_return:   return "\r";
+		case cap::clr_eol:           return "\x1b[K";
+		case cap::column_address:    return "\x1b[%i%p1%dG";
+		case cap::cursor_address:    return "\x1b[%i%p1%d;%p2%dH";
+		case cap::cursor_left:       return "\b";
+		case cap::cursor_right:      return "\x1b[C";
+		case cap::cursor_up:         return "\x1b[A";
+		case cap::parm_down_cursor:  return "\x1b[%p1%dB";
+		case cap::parm_left_cursor:  return "\x1b[%p1%dD";
+		case cap::parm_right_cursor: return "\x1b[%p1%dC";
+		case cap::parm_up_cursor:    return "\x1b[%p1%dA";
+		case cap::row_address:       return "\x1b[%i%p1%dd";
+		default:                     return {};
+		}
+	}
+
+	unsigned get_glyph_size(const std::uint32_t glyph) noexcept
+	{
+		unsigned size = 0;
+		for (auto rest = glyph; rest != 0; rest >>= 8)
+			++size;
+		return size;
+	}
+
+	void put_times(cons::OutputBuffer& buf, const std::string& str, unsigned count)
+	{
+		while (count-- > 0)
+			buf.append(str);
+	}
+} // namespace
+
+namespace cons
+{
+	UpdateEncoder::UpdateEncoder(const Terminfo& terminfo)
+	{
+		const auto read = [&terminfo](const cap c)
+		{
+			return std::string(terminfo.is_loaded() ? terminfo.get_string(c) : get_ansi_default(c));
+		};
+
+		caps_[cup_row] = read(cap::cursor_address);
+		if (caps_[cup_row].empty()) // Nothing can be drawn without it
+			caps_[cup_row] = get_ansi_default(cap::cursor_address);
+		caps_[cup_col] = caps_[cup_row];
+		caps_[hpa] = read(cap::column_address);
+		caps_[vpa] = read(cap::row_address);
+		caps_[cuf] = read(cap::parm_right_cursor);
+		caps_[cub] = read(cap::parm_left_cursor);
+		caps_[cuu] = read(cap::parm_up_cursor);
+		caps_[cud] = read(cap::parm_down_cursor);
+		caps_[rep] = read(cap::repeat_char);
+
+		cr_ = read(cap::carriage_return);
+		cub1_ = read(cap::cursor_left);
+		cuf1_ = read(cap::cursor_right);
+		cuu1_ = read(cap::cursor_up);
+		cud1_ = read(cap::cursor_down);
+		el_ = read(cap::clr_eol);
+
+		// A line feed may also return the carriage, so it is only used
+		// after one
+		if (cud1_ == "\n")
+			cud1_.clear();
+
+		const auto cup_base = static_cast<unsigned>(Terminfo::expand(caps_[cup_row], { 0, 0 }).size());
+		for (unsigned c = 0; c < PARAM_CAP_COUNT; ++c)
+		{
+			if (caps_[c].empty())
+				continue;
+
+			auto& table = costs_[c];
+			table.resize(TABLE_SIZE);
+			for (unsigned n = 0; n < TABLE_SIZE; ++n)
+			{
+				switch (static_cast<param_cap>(c))
+				{
+				case cup_row:
+					table[n] = static_cast<unsigned>(Terminfo::expand(caps_[c], { static_cast<int>(n), 0 }).size());
+					break;
+				case cup_col:
+					table[n] = static_cast<unsigned>(Terminfo::expand(caps_[c], { 0, static_cast<int>(n) }).size()) - cup_base;
+					break;
+				case rep:
+					table[n] = static_cast<unsigned>(Terminfo::expand(caps_[c], { 'x', static_cast<int>(n) }).size());
+					break;
+				default:
+					table[n] = static_cast<unsigned>(Terminfo::expand(caps_[c], { static_cast<int>(n) }).size());
+					break;
+				}
+			}
+		}
+	}
+
+	const UpdateEncoder& UpdateEncoder::get()
+	{
+		static const UpdateEncoder s_encoder(TerminalInfo::get().get_terminfo());
+		return s_encoder;
+	}
+
+	unsigned UpdateEncoder::get_move_cost(const position from, const position to,
+		const screen_cell* row, const std::uint32_t style) const
+	{
+		return get_plan(from, to, row, style).cost;
+	}
+
+	void UpdateEncoder::move(OutputBuffer& buf, const position from, const position to,
+		const screen_cell* row, const std::uint32_t style) const
+	{
+		const auto chosen = get_plan(from, to, row, style);
+		switch (chosen.how)
+		{
+		case strategy::absolute:
+			Terminfo::expand(buf, caps_[cup_row], { static_cast<int>(to.y), static_cast<int>(to.x) });
+			break;
+
+		case strategy::relative:
+			put_vertical(buf, from.y, to.y, chosen.v);
+			put_horizontal(buf, from.x, to.x, row, chosen.h);
+			break;
+
+		case strategy::carriage_return:
+			buf.append(cr_);
+			put_vertical(buf, from.y, to.y, chosen.v);
+			put_horizontal(buf, 0, to.x, row, chosen.h);
+			break;
+
+		case strategy::newline:
+			for (auto y = from.y; y < to.y; ++y)
+			{
+				buf.append(cr_);
+				buf.append('\n');
+			}
+			put_horizontal(buf, 0, to.x, row, chosen.h);
+			break;
+		}
+	}
+
+	unsigned UpdateEncoder::get_repeat_cost(const unsigned count) const
+	{
+		return s_repeat_enabled.load(std::memory_order_relaxed) ? get_cost(rep, count) : UNAVAILABLE;
+	}
+
+	void UpdateEncoder::set_repeat_enabled(const bool enabled) noexcept
+	{
+		s_repeat_enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	void UpdateEncoder::repeat(OutputBuffer& buf, const char ch, const unsigned count) const
+	{
+		Terminfo::expand(buf, caps_[rep], { static_cast<unsigned char>(ch), static_cast<int>(count) });
+	}
+
+	unsigned UpdateEncoder::get_cost(const param_cap c, const unsigned param) const
+	{
+		if (caps_[c].empty())
+			return UNAVAILABLE;
+		if (param < TABLE_SIZE)
+			return costs_[c][param];
+
+		// Past the tables, which only happens on very large terminals
+		const auto n = static_cast<int>(param);
+		switch (c)
+		{
+		case cup_row: return static_cast<unsigned>(Terminfo::expand(caps_[c], { n, 0 }).size());
+		case cup_col: return static_cast<unsigned>(Terminfo::expand(caps_[c], { 0, n }).size()
+			- Terminfo::expand(caps_[c], { 0, 0 }).size());
+		case rep:     return static_cast<unsigned>(Terminfo::expand(caps_[c], { 'x', n }).size());
+		default:      return static_cast<unsigned>(Terminfo::expand(caps_[c], { n }).size());
+		}
+	}
+
+	unsigned UpdateEncoder::get_vertical(const unsigned from_y, const unsigned to_y, vertical& v) const
+	{
+		v = vertical::none;
+		if (from_y == to_y)
+			return 0;
+
+		const bool down = to_y > from_y;
+		const auto distance = down ? to_y - from_y : from_y - to_y;
+		const auto& single = down ? cud1_ : cuu1_;
+
+		auto best = get_cost(down ? cud : cuu, distance);
+		v = vertical::parm;
+		if (!single.empty() && single.size() * distance < best)
+		{
+			best = static_cast<unsigned>(single.size()) * distance;
+			v = vertical::single;
+		}
+		if (const auto address = get_cost(vpa, to_y); address < best)
+		{
+			best = address;
+			v = vertical::address;
+		}
+		return best;
+	}
+
+	unsigned UpdateEncoder::get_horizontal(const unsigned from_x, const unsigned to_x,
+		const screen_cell* row, const std::uint32_t style, horizontal& h) const
+	{
+		h = horizontal::none;
+		if (from_x == to_x)
+			return 0;
+
+		const bool right = to_x > from_x;
+		const auto distance = right ? to_x - from_x : from_x - to_x;
+		const auto& single = right ? cuf1_ : cub1_;
+
+		auto best = get_cost(right ? cuf : cub, distance);
+		h = horizontal::parm;
+		if (!single.empty() && single.size() * distance < best)
+		{
+			best = static_cast<unsigned>(single.size()) * distance;
+			h = horizontal::single;
+		}
+		if (const auto address = get_cost(hpa, to_x); address < best)
+		{
+			best = address;
+			h = horizontal::address;
+		}
+
+		if (right && row != nullptr && distance < best)
+		{ // Writing the characters already there moves the cursor too
+			unsigned cost = 0;
+			for (auto x = from_x; x < to_x && cost < best; ++x)
+			{
+				if (row[x].style != style || row[x].glyph == 0)
+				{
+					cost = UNAVAILABLE;
+					break;
+				}
+				cost += get_glyph_size(row[x].glyph);
+			}
+			if (cost < best)
+			{
+				best = cost;
+				h = horizontal::rewrite;
+			}
+		}
+		return best;
+	}
+
+	UpdateEncoder::plan UpdateEncoder::get_plan(const position from, const position to,
+		const screen_cell* row, const std::uint32_t style) const
+	{
+		plan best{ get_cost(cup_row, to.y) + get_cost(cup_col, to.x),
+			strategy::absolute, vertical::none, horizontal::none };
+		if (from.x == UNKNOWN || from.y == UNKNOWN)
+			return best;
+
+		vertical v;
+		horizontal h;
+		const auto vertical_cost = get_vertical(from.y, to.y, v);
+		if (const auto cost = vertical_cost + get_horizontal(from.x, to.x, row, style, h);
+			cost < best.cost)
+			best = { cost, strategy::relative, v, h };
+
+		if (!cr_.empty())
+		{
+			const auto cr_cost = static_cast<unsigned>(cr_.size());
+			const auto from_start = get_horizontal(0, to.x, row, style, h);
+			if (const auto cost = cr_cost + vertical_cost + from_start; cost < best.cost)
+				best = { cost, strategy::carriage_return, v, h };
+
+			if (to.y > from.y)
+			{
+				const auto cost = (cr_cost + 1) * (to.y - from.y) + from_start;
+				if (cost < best.cost)
+					best = { cost, strategy::newline, vertical::none, h };
+			}
+		}
+		return best;
+	}
+
+	void UpdateEncoder::put_vertical(OutputBuffer& buf, const unsigned from_y,
+		const unsigned to_y, const vertical v) const
+	{
+		const bool down = to_y > from_y;
+		const auto distance = down ? to_y - from_y : from_y - to_y;
+		switch (v)
+		{
+		case vertical::none:
+			break;
+		case vertical::parm:
+			Terminfo::expand(buf, caps_[down ? cud : cuu], { static_cast<int>(distance) });
+			break;
+		case vertical::single:
+			put_times(buf, down ? cud1_ : cuu1_, distance);
+			break;
+		case vertical::address:
+			Terminfo::expand(buf, caps_[vpa], { static_cast<int>(to_y) });
+			break;
+		}
+	}
+
+	void UpdateEncoder::put_horizontal(OutputBuffer& buf, const unsigned from_x,
+		const unsigned to_x, const screen_cell* row, const horizontal h) const
+	{
+		const bool right = to_x > from_x;
+		const auto distance = right ? to_x - from_x : from_x - to_x;
+		switch (h)
+		{
+		case horizontal::none:
+			break;
+		case horizontal::parm:
+			Terminfo::expand(buf, caps_[right ? cuf : cub], { static_cast<int>(distance) });
+			break;
+		case horizontal::single:
+			put_times(buf, right ? cuf1_ : cub1_, distance);
+			break;
+		case horizontal::address:
+			Terminfo::expand(buf, caps_[hpa], { static_cast<int>(to_x) });
+			break;
+		case horizontal::rewrite:
+			for (auto x = from_x; x < to_x; ++x)
+				put_glyph(buf, row[x].glyph);
+			break;
+		}
+	}
+} // namespace cons
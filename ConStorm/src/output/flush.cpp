@@ -0,0 +1,67 @@
+/*
+ Code by Drake Johnson
+*/
+#include "../../include/cons/output/flush.hpp"
+#include "../../include/cons/output/buffer.hpp"
+#include <atomic>
+#include <iostream>
+#include <mutex>
+
+namespace
+{
+	std::atomic<cons::FlushPolicy> s_flush_policy{ cons::FlushPolicy::on_frame };
+
+	/**
+	 Installed as std::cin's tie. Before every read from std::cin, flushes
+	 the stream std::cin was tied to before (normally std::cout), then the
+	 calling thread's OutputBuffer.
+	*/
+	class input_tie final : public std::streambuf
+	{
+	public:
+		explicit input_tie(std::ostream* prev_tie) : prev_tie_(prev_tie) {}
+
+	protected:
+		int sync() override
+		{
+			if (prev_tie_ != nullptr)
+				prev_tie_->flush();
+			cons::flush_before_input();
+			return 0;
+		}
+
+	private:
+		std::ostream* prev_tie_;
+	};
+
+	void install_input_tie()
+	{
+		static std::once_flag s_installed;
+		std::call_once(s_installed, []
+		{
+			static input_tie tie_buf(std::cin.tie());
+			static std::ostream tie_stream(&tie_buf);
+			std::cin.tie(&tie_stream);
+		});
+	}
+} // namespace
+
+namespace cons
+{
+	void set_flush_policy(const FlushPolicy policy)
+	{
+		install_input_tie();
+		s_flush_policy.store(policy);
+	}
+
+	FlushPolicy get_flush_policy() noexcept
+	{
+		return s_flush_policy.load(std::memory_order_relaxed);
+	}
+
+	void flush_before_input()
+	{
+		if (get_flush_policy() != FlushPolicy::manual)
+			flush_async();
+	}
+} // namespace cons
@@ -0,0 +1,202 @@
+/*
+ Code by Drake Johnson
+*/
+#include "../../include/cons/output/format.hpp"
+#include <memory>
+#include <vector>
+
+namespace
+{
+	/**
+	 The calling thread's buffers for 'format()', one per level of nesting
+	*/
+	thread_local std::vector<std::unique_ptr<cons::OutputBuffer>> t_scratch;
+	thread_local size_t t_scratch_depth = 0;
+
+	bool is_continuation(const char ch) noexcept
+	{
+		return (static_cast<unsigned char>(ch) & 0xC0) == 0x80;
+	}
+
+	/**
+	 @returns The number of columns `text` takes on the terminal: one per
+	          UTF-8 character, none for escape sequences
+	*/
+	size_t get_columns(const std::string_view text) noexcept
+	{
+		size_t columns = 0;
+		for (size_t i = 0; i < text.size(); ++i)
+		{
+			if (text[i] == '\x1b')
+			{ // A CSI sequence ends at its final byte; others are two bytes
+				if (++i < text.size() && text[i] == '[')
+				{
+					while (++i < text.size() && (text[i] < 0x40 || text[i] > 0x7E))
+					{}
+				}
+				continue;
+			}
+			if (!is_continuation(text[i]))
+				++columns;
+		}
+		return columns;
+	}
+
+	char to_upper(const char ch) noexcept
+	{
+		return ch >= 'a' && ch <= 'z' ? static_cast<char>(ch - 'a' + 'A') : ch;
+	}
+
+	/**
+	 @returns The sign character to print for a number, or '\0' for none
+	*/
+	char sign_char(const bool negative, const char sign) noexcept
+	{
+		if (negative)
+			return '-';
+		return sign == '+' || sign == ' ' ? sign : '\0';
+	}
+
+	/**
+	 Writes the sign and prefix of a number, then its digits, padded to the
+	 width of `seg` with zeros (between the prefix and the digits) or with the
+	 fill character
+	*/
+	void write_number(cons::OutputBuffer& buf, const char sign,
+		const std::string_view prefix, const std::string_view digits,
+		const cons::detail::fmt_segment& seg)
+	{
+		const auto begin = buf.size();
+		if (sign != '\0')
+			buf.append(sign);
+		buf.append(prefix);
+
+		const auto length = buf.size() - begin + digits.size();
+		if (seg.zero && seg.align == cons::detail::fmt_align::none &&
+			length < seg.width)
+		{
+			buf.append(seg.width - length, '0');
+		}
+
+		buf.append(digits);
+		cons::detail::fmt_pad(buf, begin, seg, cons::detail::fmt_align::right);
+	}
+} // namespace
+
+namespace cons
+{
+	namespace detail
+	{
+		fmt_scratch::fmt_scratch()
+		{
+			if (t_scratch_depth == t_scratch.size())
+				t_scratch.push_back(std::make_unique<OutputBuffer>());
+			buf_ = t_scratch[t_scratch_depth++].get();
+		}
+
+		fmt_scratch::~fmt_scratch()
+		{
+			// Also forgets the attributes of a format which threw
+			buf_->reset_attributes();
+			buf_->clear();
+			--t_scratch_depth;
+		}
+
+		void fmt_pad(OutputBuffer& buf, const size_t begin, const fmt_segment& seg,
+			const fmt_align default_align)
+		{
+			const auto length = get_columns(std::string_view(buf.data() + begin, buf.size() - begin));
+			if (length >= seg.width)
+				return;
+
+			const auto padding = seg.width - length;
+			switch (seg.align == fmt_align::none ? default_align : seg.align)
+			{
+			case fmt_align::right:
+				buf.insert(begin, padding, seg.fill);
+				break;
+
+			case fmt_align::center:
+				buf.insert(begin, padding / 2, seg.fill);
+				buf.append(padding - padding / 2, seg.fill);
+				break;
+
+			default:
+				buf.append(padding, seg.fill);
+				break;
+			}
+		}
+
+		size_t fmt_prefix_size(const std::string_view str, size_t count) noexcept
+		{
+			size_t end = 0;
+			for (; end < str.size(); ++end)
+			{
+				if (is_continuation(str[end]))
+					continue;
+				if (count == 0)
+					break;
+				--count;
+			}
+			return end;
+		}
+
+		void fmt_write_integer(OutputBuffer& buf, const unsigned long long magnitude,
+			const bool negative, const fmt_segment& seg)
+		{
+			auto base = 10;
+			std::string_view prefix;
+			switch (seg.type)
+			{
+			case 'x': base = 16; prefix = "0x"; break;
+			case 'X': base = 16; prefix = "0X"; break;
+			case 'o': base = 8;  prefix = "0o"; break;
+			case 'b': base = 2;  prefix = "0b"; break;
+			case 'B': base = 2;  prefix = "0B"; break;
+			default: break;
+			}
+
+			char digits[64];
+			const auto result = std::to_chars(digits, digits + sizeof(digits),
+				magnitude, base);
+			const auto size = static_cast<size_t>(result.ptr - digits);
+
+			if (seg.type == 'X')
+			{
+				for (size_t i = 0; i < size; ++i)
+					digits[i] = to_upper(digits[i]);
+			}
+
+			write_number(buf, sign_char(negative, seg.sign),
+				seg.alt ? prefix : std::string_view(),
+				std::string_view(digits, size), seg);
+		}
+
+		void fmt_write_floating(OutputBuffer& buf, const char* digits,
+			size_t size, const fmt_segment& seg)
+		{
+			const auto negative = size > 0 && digits[0] == '-';
+			if (negative)
+			{
+				++digits;
+				--size;
+			}
+
+			const auto upper = seg.type == 'F' || seg.type == 'E' || seg.type == 'G';
+			if (upper)
+			{
+				char upper_digits[FMT_FLOAT_BUFFER_SIZE];
+				for (size_t i = 0; i < size; ++i)
+					upper_digits[i] = to_upper(digits[i]);
+
+				write_number(buf, sign_char(negative, seg.sign), std::string_view(),
+					std::string_view(upper_digits, size), seg);
+			}
+			else
+			{
+				write_number(buf, sign_char(negative, seg.sign), std::string_view(),
+					std::string_view(digits, size), seg);
+			}
+		}
+	} // namespace detail
+} // namespace cons
@@ -0,0 +1,19 @@
+/*
+ Code by Drake Johnson
+*/
+#include "../../include/cons/output/formatter.hpp"
+
+namespace cons
+{
+	namespace detail
+	{
+		println_redirect::println_redirect(OutputBuffer& buf)
+			: prev_target_(set_output_target(&buf))
+		{}
+
+		println_redirect::~println_redirect()
+		{
+			set_output_target(prev_target_);
+		}
+	} // namespace detail
+} // namespace cons
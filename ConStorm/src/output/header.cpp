@@ -4,13 +4,28 @@
 
 #include <cons/output/header.hpp>
 #include <cons/output/prompt.hpp>
+#include <cons/output/backend.hpp>
 
-namespace cons
+namespace
 {
-	COORD Header::U_COORD::get_short() const
+	/**
+	 @returns The number of columns `str` takes, counting one per UTF-8
+	          character
+	*/
+	int get_columns(const std::string_view str) noexcept
 	{
-		return { static_cast<SHORT>(X), static_cast<SHORT>(Y) };
+		int columns = 0;
+		for (const char ch : str)
+		{
+			if ((static_cast<unsigned char>(ch) & 0xC0) != 0x80)
+				++columns;
+		}
+		return columns;
 	}
+} // namespace
+
+namespace cons
+{
 	Header::U_COORD& Header::U_COORD::operator=(U_COORD other)
 	{
 		if (this != &other)
@@ -34,36 +49,49 @@ namespace cons
 	Header::Header(std::string text)
 		: textf(std::move(text))
 		, cursor_location_(get_live_console_cursor())
-		, update_cursor_(true)
 	{}
 
 	void Header::display() const
 	{
-		const auto old_attribs = setup_console();
-		print(text_);
-		cursor_location_.Y++; // Dashed line on next line
-		const auto dummy_attribs = setup_console(); // Reposition cursor
-		prompt(std::string(text_.size() + 2, '-'));
-		restore_console(old_attribs);
+		OutputFrame frame;
+		display(out());
 	}
 
-	void Header::set_console_cursor(U_COORD position)
+	void Header::display(OutputBuffer& buf) const
 	{
-		HANDLE hstdout = GetStdHandle(STD_OUTPUT_HANDLE);
-		CONSOLE_SCREEN_BUFFER_INFO csbi;
+		if constexpr (console_backend::INLINE_STYLES)
+		{ // One copy of the pre-built bytes, between the color changes
+			const auto& rendered = get_rendered();
+			buf.set_attributes(rendered.attributes, rendered.sequence);
+			buf.append(rendered.body);
+			restore_console(buf);
+		}
+		else
+		{ // The console API moves the cursor, so there are no bytes to cache
+			setup_console(buf);
+			buf.append(text_);
+			if (!TerminalInfo::get().is_styled())
+				buf.append('\n');
+			else if (cursor_location_ == get_live_console_cursor())
+				console_backend::move_cursor_by(buf, -get_columns(text_), 1);
+			else
+				console_backend::move_cursor(buf, cursor_location_.X, cursor_location_.Y + 1);
+			buf.append(static_cast<size_t>(get_columns(text_)) + 2, '-');
+			restore_console(buf);
+		}
+	}
 
-		// Get number of char cells in current buffer
-		if (!GetConsoleScreenBufferInfo(hstdout, &csbi))
+	void Header::set_console_cursor(U_COORD position)
+	{
+		// Positions outside of the terminal are rejected, unless its size is
+		// unknown (such as when the output is not a terminal)
+		auto& terminal = TerminalInfo::get();
+		if (terminal.is_stdout_tty() && (position.X >= terminal.get_columns()
+			|| position.Y >= terminal.get_rows()))
 			return;
 
-		const auto& maxX = static_cast<unsigned>(csbi.dwSize.X);
-		const auto& maxY = static_cast<unsigned>(csbi.dwSize.Y);
-
-		if (position.X <= maxX && position.Y <= maxY)
-		{
-			cursor_location_ = position;
-			update_cursor_ = false;
-		}
+		cursor_location_ = position;
+		cache_.valid = false;
 	}
 
 	void Header::set_console_cursor(const unsigned x, const unsigned y)
@@ -76,21 +104,6 @@ namespace cons
 		return cursor_location_;
 	}
 
-	Header::U_COORD Header::get_console_cursor_pos()
-	{
-		HANDLE hstdout = GetStdHandle(STD_OUTPUT_HANDLE);
-		CONSOLE_SCREEN_BUFFER_INFO csbi;
-		GetConsoleScreenBufferInfo(hstdout, &csbi);
-
-		U_COORD pos
-		{
-			static_cast<unsigned>(csbi.dwCursorPosition.X),
-			static_cast<unsigned>(csbi.dwCursorPosition.Y)
-		};
-
-		return pos;
-	}
-
 	Header::U_COORD Header::get_live_console_cursor()
 	{
 		static constexpr auto cx = static_cast<unsigned>(-1);
@@ -99,36 +112,36 @@ namespace cons
 		return U_COORD{ cx, cy };
 	}
 
-	WORD Header::setup_console() const
+	const Header::render_cache& Header::get_rendered() const
 	{
-		const auto old_attribs = textf::setup_console();
-
-		auto hout = GetStdHandle(STD_OUTPUT_HANDLE);
-
-		try
-		{
-			if (cursor_location_ == get_live_console_cursor())
-				cursor_location_ = get_console_cursor_pos();
-
-			if (!SetConsoleCursorPosition(hout, cursor_location_.get_short()))
-				throw WindowsConsoleFailureException();
-		}
-		catch (const WindowsConsoleFailureException& e)
-		{
-			std::cerr << e.what() << std::endl;
-		}
-
-		return old_attribs;
+		// Styling can be switched at any time, so it is checked as well
+		const bool styled = TerminalInfo::get().is_styled();
+		if (cache_.valid && cache_.styled == styled)
+			return cache_;
+
+		cache_.valid = true;
+		cache_.attributes = ConsoleColor::get_attribute_id(color_);
+		cache_.styled = styled;
+		cache_.sequence = ConsoleColor::get_ansi_sequence(color_).view();
+
+		OutputBuffer scratch;
+		if (!(cursor_location_ == get_live_console_cursor()))
+			console_backend::move_cursor(scratch, cursor_location_.X, cursor_location_.Y);
+		scratch.append(text_);
+		const auto columns = get_columns(text_);
+		if (styled) // Back to the first character, then down a line (scrolling if needed)
+			console_backend::move_cursor_by(scratch, -columns, 1);
+		else // Piped output has no cursor to move
+			scratch.append('\n');
+		scratch.append(static_cast<size_t>(columns) + 2, '-');
+		cache_.body.assign(scratch.data(), scratch.size());
+		return cache_;
 	}
 
-	void Header::restore_console(const WORD old_attribs) const
+	void Header::setup_console(OutputBuffer& buf) const
 	{
-		textf::restore_console(old_attribs);
-
-		// Set cursor location if `update_cursor_`
-		if (update_cursor_) // Reset back to "live cursor" value
-			cursor_location_ = get_live_console_cursor();
-		else // Restore back to original
-			cursor_location_.Y--;
+		textf::setup_console(buf);
+		if (!(cursor_location_ == get_live_console_cursor()))
+			console_backend::move_cursor(buf, cursor_location_.X, cursor_location_.Y);
 	}
 } // namespace cons
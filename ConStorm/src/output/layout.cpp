@@ -0,0 +1,525 @@
+/*
+ Code by Drake Johnson
+
+ Defines the Layout class
+*/
+#include <cons/output/layout.hpp>
+#include <algorithm>
+#include <string>
+
+namespace
+{
+	bool is_continuation(const char ch) noexcept
+	{
+		return (static_cast<unsigned char>(ch) & 0xC0) == 0x80;
+	}
+
+	/**
+	 @returns The first `columns` characters of `str`
+	*/
+	std::string_view clip(const std::string_view str, unsigned columns) noexcept
+	{
+		size_t end = 0;
+		for (; end < str.size(); ++end)
+		{
+			if (is_continuation(str[end]))
+				continue;
+			if (columns == 0)
+				break;
+			--columns;
+		}
+		return str.substr(0, end);
+	}
+
+	/**
+	 @returns The width of the longest line of `str`, with tabs as
+	          `tab_spaces` spaces
+	*/
+	unsigned get_longest_line(const std::string_view str, const unsigned tab_spaces) noexcept
+	{
+		unsigned longest = 0;
+		unsigned width = 0;
+		for (const auto ch : str)
+		{
+			if (ch == '\n')
+			{
+				longest = std::max(longest, width);
+				width = 0;
+			}
+			else if (ch == '\t')
+				width += tab_spaces;
+			else if (!is_continuation(ch))
+				++width;
+		}
+		return std::max(longest, width);
+	}
+
+	unsigned subtract(const unsigned value, const unsigned amount) noexcept
+	{
+		return value > amount ? value - amount : 0;
+	}
+} // namespace
+
+namespace cons
+{
+	Layout::Layout(const direction root_direction)
+	{
+		node root;
+		root.type = kind::box;
+		root.dir = root_direction;
+		root.size = LayoutSize::flex();
+		nodes_.push_back(std::move(root));
+	}
+
+	Layout::node_id Layout::add_box(const node_id parent, const direction dir, const LayoutSize size)
+	{
+		node n;
+		n.type = kind::box;
+		n.dir = dir;
+		n.size = size;
+		return add(parent, std::move(n));
+	}
+
+	Layout::node_id Layout::add_header(const node_id parent, Header header, const LayoutSize size)
+	{
+		node n;
+		n.type = kind::header;
+		n.size = size;
+		n.header = std::move(header);
+		return add(parent, std::move(n));
+	}
+
+	Layout::node_id Layout::add_text(const node_id parent, StyledText text,
+		const unsigned char_count, const unsigned tab_spaces, const LayoutSize size)
+	{
+		node n;
+		n.type = kind::text;
+		n.size = size;
+		n.text = std::move(text);
+		n.char_count = char_count;
+		n.tab_spaces = tab_spaces;
+		return add(parent, std::move(n));
+	}
+
+	Layout::node_id Layout::add_text(const node_id parent, const WordWrap& text, const LayoutSize size)
+	{
+		const auto id = add_text(parent, StyledText(), WordWrap::TERMINAL_WIDTH, 4U, size);
+		set_text(id, text);
+		return id;
+	}
+
+	Layout::node_id Layout::add_slot(const node_id parent, const unsigned columns,
+		const unsigned rows, const LayoutSize size)
+	{
+		node n;
+		n.type = kind::slot;
+		n.size = size;
+		n.slot_columns = columns;
+		n.slot_rows = rows;
+		return add(parent, std::move(n));
+	}
+
+	void Layout::set_size(const node_id id, const LayoutSize size)
+	{
+		nodes_[id].size = size;
+		mark_dirty(id);
+	}
+
+	void Layout::set_padding(const node_id id, const LayoutPadding padding)
+	{
+		nodes_[id].padding = padding;
+		mark_dirty(id);
+	}
+
+	void Layout::set_border(const node_id id, const bool border)
+	{
+		nodes_[id].border = border;
+		mark_dirty(id);
+	}
+
+	void Layout::set_header(const node_id id, Header header)
+	{
+		nodes_[id].header = std::move(header);
+		mark_dirty(id);
+	}
+
+	void Layout::set_text(const node_id id, StyledText text)
+	{
+		nodes_[id].text = std::move(text);
+		mark_dirty(id);
+	}
+
+	void Layout::set_text(const node_id id, const WordWrap& text)
+	{
+		auto& n = nodes_[id];
+		n.char_count = text.get_char_count();
+		n.tab_spaces = text.get_tab_spaces();
+
+		if (text.get_styled_lines().empty())
+			n.text = StyledText(text.get_source());
+		else
+		{ // Only the wrapped lines keep the colors
+			n.text.clear();
+			for (const auto& line : text.get_styled_lines())
+			{
+				if (!n.text.empty())
+					n.text.append("\n");
+				n.text.append(line);
+			}
+		}
+		mark_dirty(id);
+	}
+
+	void Layout::set_slot(const node_id id, const unsigned columns, const unsigned rows)
+	{
+		auto& n = nodes_[id];
+		if (n.slot_columns == columns && n.slot_rows == rows)
+			return;
+
+		n.slot_columns = columns;
+		n.slot_rows = rows;
+		mark_dirty(id);
+	}
+
+	unsigned Layout::get_columns(const std::string_view str) noexcept
+	{
+		return static_cast<unsigned>(std::count_if(str.begin(), str.end(),
+			[](const char ch) { return !is_continuation(ch); }));
+	}
+
+	bool Layout::update(const unsigned columns, const unsigned rows)
+	{
+		return arrange(ROOT, { 0, 0, columns, rows });
+	}
+
+	LayoutRect Layout::get_rect(const node_id id) const
+	{
+		auto rect = nodes_[id].rect;
+		for (auto i = id; i != ROOT;)
+		{
+			i = nodes_[i].parent;
+			rect.x += nodes_[i].rect.x;
+			rect.y += nodes_[i].rect.y;
+		}
+		return rect;
+	}
+
+	LayoutRect Layout::get_content_rect(const node_id id) const
+	{
+		const auto& n = nodes_[id];
+		const unsigned edge = n.border ? 1 : 0;
+		auto rect = get_rect(id);
+		rect.x += edge + n.padding.left;
+		rect.y += edge + n.padding.top;
+		rect.width = subtract(rect.width, get_inset_width(n));
+		rect.height = subtract(rect.height, get_inset_height(n));
+		return rect;
+	}
+
+	void Layout::draw(Screen& screen) const
+	{
+		draw(screen, ROOT, 0, 0);
+	}
+
+	Layout::node_id Layout::add(const node_id parent, node n)
+	{
+		const auto id = static_cast<node_id>(nodes_.size());
+		n.parent = parent;
+		nodes_.push_back(std::move(n));
+		nodes_[parent].children.push_back(id);
+		mark_dirty(id);
+		return id;
+	}
+
+	void Layout::mark_dirty(node_id id)
+	{
+		// The measurements of every ancestor include this node's
+		for (;;)
+		{
+			auto& n = nodes_[id];
+			n.dirty = true;
+			n.natural_width = UNMEASURED;
+			n.measured_width = UNMEASURED;
+			if (id == ROOT)
+				break;
+			id = n.parent;
+		}
+	}
+
+	unsigned Layout::get_inset_width(const node& n) const noexcept
+	{
+		return n.padding.left + n.padding.right + (n.border ? 2 : 0);
+	}
+
+	unsigned Layout::get_inset_height(const node& n) const noexcept
+	{
+		return n.padding.top + n.padding.bottom + (n.border ? 2 : 0);
+	}
+
+	unsigned Layout::measure_width(const node_id id)
+	{
+		if (nodes_[id].natural_width != UNMEASURED)
+			return nodes_[id].natural_width;
+		++measure_count_;
+
+		const auto& n = nodes_[id];
+		unsigned width = 0;
+		switch (n.type)
+		{
+		case kind::header:
+			width = get_columns(n.header.get_text()) + 2; // The underline's width
+			break;
+
+		case kind::text:
+			width = get_longest_line(n.text.get_text(), n.tab_spaces);
+			if (n.char_count != WordWrap::TERMINAL_WIDTH)
+				width = std::min(width, n.char_count);
+			break;
+
+		case kind::slot:
+			width = n.slot_columns;
+			break;
+
+		case kind::box:
+			for (const auto child : n.children)
+			{
+				const auto& c = nodes_[child];
+				const auto child_width = n.dir == direction::row && c.size.type == LayoutSize::kind::fixed
+					? c.size.value : measure_width(child);
+				width = n.dir == direction::row ? width + child_width : std::max(width, child_width);
+			}
+			break;
+		}
+
+		nodes_[id].natural_width = width + get_inset_width(n);
+		return nodes_[id].natural_width;
+	}
+
+	unsigned Layout::measure_height(const node_id id, const unsigned width)
+	{
+		if (nodes_[id].measured_width == width)
+			return nodes_[id].measured_height;
+		++measure_count_;
+
+		auto& n = nodes_[id];
+		const auto inner = subtract(width, get_inset_width(n));
+		unsigned height = 0;
+		switch (n.type)
+		{
+		case kind::header:
+			height = 2; // The title and its underline
+			break;
+
+		case kind::text:
+		{
+			auto limit = inner;
+			if (n.char_count != WordWrap::TERMINAL_WIDTH)
+				limit = std::min(limit, n.char_count);
+			limit = std::max(limit, 1U); // 0 would mean the terminal's width
+
+			if (n.text.get_runs().empty())
+				n.wrapped = WordWrap(n.text.get_text(), limit, n.tab_spaces);
+			else
+				n.wrapped = WordWrap(n.text, limit, n.tab_spaces);
+			height = static_cast<unsigned>(n.wrapped.get_lines().size());
+			break;
+		}
+
+		case kind::slot:
+			height = n.slot_rows;
+			break;
+
+		case kind::box:
+			if (n.dir == direction::column)
+			{
+				for (const auto child : n.children)
+				{
+					const auto& c = nodes_[child];
+					height += c.size.type == LayoutSize::kind::fixed
+						? c.size.value : measure_height(child, inner);
+				}
+			}
+			else
+			{
+				std::vector<unsigned> widths;
+				distribute(n, inner, 0, widths);
+				for (size_t i = 0; i < n.children.size(); ++i)
+					height = std::max(height, measure_height(n.children[i], widths[i]));
+			}
+			break;
+		}
+
+		auto& measured = nodes_[id];
+		measured.measured_width = width;
+		measured.measured_height = height + get_inset_height(measured);
+		return measured.measured_height;
+	}
+
+	void Layout::distribute(const node& box, const unsigned length, const unsigned cross,
+		std::vector<unsigned>& sizes)
+	{
+		sizes.assign(box.children.size(), 0);
+		unsigned used = 0;
+		unsigned weights = 0;
+		for (size_t i = 0; i < box.children.size(); ++i)
+		{
+			const auto child = box.children[i];
+			const auto size = nodes_[child].size;
+			switch (size.type)
+			{
+			case LayoutSize::kind::fixed:
+				sizes[i] = size.value;
+				break;
+			case LayoutSize::kind::content:
+				sizes[i] = box.dir == direction::column ? measure_height(child, cross) : measure_width(child);
+				break;
+			case LayoutSize::kind::flex:
+				weights += std::max(size.value, 1U);
+				continue;
+			}
+			used += sizes[i];
+		}
+		if (weights == 0)
+			return;
+
+		// What is left is shared by weight, and the last flexible node
+		// takes what rounding leaves over
+		const auto remaining = subtract(length, used);
+		unsigned given = 0;
+		unsigned weight_so_far = 0;
+		for (size_t i = 0; i < box.children.size(); ++i)
+		{
+			const auto size = nodes_[box.children[i]].size;
+			if (size.type != LayoutSize::kind::flex)
+				continue;
+
+			weight_so_far += std::max(size.value, 1U);
+			const auto share = static_cast<unsigned>(
+				static_cast<unsigned long long>(remaining) * weight_so_far / weights);
+			sizes[i] = share - given;
+			given = share;
+		}
+	}
+
+	bool Layout::arrange(const node_id id, const LayoutRect rect)
+	{
+		{
+			auto& n = nodes_[id];
+			const bool resized = n.rect.width != rect.width || n.rect.height != rect.height;
+			n.rect.x = rect.x; // A move alone changes nothing below the node
+			n.rect.y = rect.y;
+			if (!n.dirty && !resized)
+				return false;
+
+			n.rect = rect;
+			n.dirty = false;
+			++arrange_count_;
+		}
+
+		const auto& n = nodes_[id];
+		if (n.type == kind::text)
+			measure_height(id, rect.width); // Wraps the text to the width
+		if (n.type != kind::box)
+			return true;
+
+		const auto edge = n.border ? 1U : 0U;
+		const auto left = edge + n.padding.left;
+		const auto top = edge + n.padding.top;
+		const auto inner_width = subtract(rect.width, get_inset_width(n));
+		const auto inner_height = subtract(rect.height, get_inset_height(n));
+		const bool is_column = n.dir == direction::column;
+
+		std::vector<unsigned> sizes;
+		distribute(n, is_column ? inner_height : inner_width, is_column ? inner_width : inner_height, sizes);
+
+		unsigned offset = 0;
+		for (size_t i = 0; i < sizes.size(); ++i)
+		{
+			const auto child = nodes_[id].children[i];
+			if (is_column)
+				arrange(child, { left, top + offset, inner_width, sizes[i] });
+			else
+			{ // A row is cut off at its right edge
+				const auto width = std::min(sizes[i], subtract(inner_width, offset));
+				arrange(child, { left + std::min(offset, inner_width), top, width, inner_height });
+			}
+			offset += sizes[i];
+		}
+		return true;
+	}
+
+	void Layout::draw(Screen& screen, const node_id id, unsigned x, unsigned y) const
+	{
+		const auto& n = nodes_[id];
+		x += n.rect.x;
+		y += n.rect.y;
+		const auto width = n.rect.width;
+		const auto height = n.rect.height;
+
+		if (n.border && width >= 2 && height >= 2)
+		{
+			std::string edge(width, '-');
+			edge.front() = edge.back() = '+';
+			screen.write(x, y, edge);
+			screen.write(x, y + height - 1, edge);
+			for (unsigned row = 1; row + 1 < height; ++row)
+			{
+				screen.write(x, y + row, "|");
+				screen.write(x + width - 1, y + row, "|");
+			}
+		}
+
+		const auto edge = n.border ? 1U : 0U;
+		const auto content_x = x + edge + n.padding.left;
+		const auto content_y = y + edge + n.padding.top;
+		const auto content_width = subtract(width, get_inset_width(n));
+		const auto content_height = subtract(height, get_inset_height(n));
+
+		switch (n.type)
+		{
+		case kind::header:
+		{
+			if (content_height == 0 || content_width == 0)
+				break;
+
+			// Placed at the header's own column within the rectangle, as
+			// 'Screen::draw()' places it on the screen
+			const auto column = n.header.get_console_cursor().X;
+			const auto left = column < content_width ? column : 0U;
+			const auto available = content_width - left;
+			const auto text = n.header.get_text();
+			const auto title = clip(text, available);
+			screen.write(content_x + left, content_y, title, n.header.get_color());
+			if (content_height > 1)
+			{
+				const auto dashes = std::min(get_columns(title) + 2, available);
+				screen.write(content_x + left, content_y + 1, std::string(dashes, '-'), n.header.get_color());
+			}
+			break;
+		}
+
+		case kind::text:
+		{
+			const auto& styled = n.wrapped.get_styled_lines();
+			const auto& lines = n.wrapped.get_lines();
+			const auto shown = std::min(static_cast<unsigned>(lines.size()), content_height);
+			for (unsigned row = 0; row < shown; ++row)
+			{
+				if (styled.empty())
+					screen.write(content_x, content_y + row, lines[row]);
+				else
+					screen.write(content_x, content_y + row, styled[row]);
+			}
+			break;
+		}
+
+		case kind::slot:
+			break;
+
+		case kind::box:
+			for (const auto child : n.children)
+				draw(screen, child, x, y);
+			break;
+		}
+	}
+} // namespace cons
@@ -0,0 +1,185 @@
+/*
+ Code by Drake Johnson
+
+ Defines the LogPane class
+*/
+#include <cons/output/log_pane.hpp>
+#include <cons/output/backend.hpp>
+#include <algorithm>
+
+namespace
+{
+	/**
+	 Appends at most `columns` characters of `text`, with control
+	 characters as spaces
+
+	 @returns The number of characters appended
+	*/
+	unsigned append_clipped(cons::OutputBuffer& buf, const std::string_view text,
+		const unsigned columns)
+	{
+		unsigned width = 0;
+		size_t end = 0;
+		for (; end < text.size(); ++end)
+		{
+			const auto ch = static_cast<unsigned char>(text[end]);
+			if ((ch & 0xC0) == 0x80)
+				continue; // Continues the character before
+			if (width == columns)
+				break;
+			++width;
+		}
+
+		size_t start = 0;
+		for (size_t i = 0; i < end; ++i)
+		{
+			const auto ch = static_cast<unsigned char>(text[i]);
+			if (ch < 0x20 || ch == 0x7F)
+			{
+				buf.append(text.substr(start, i - start));
+				buf.append(' ');
+				start = i + 1;
+			}
+		}
+		buf.append(text.substr(start, end - start));
+		return width;
+	}
+} // namespace
+
+namespace cons
+{
+	LogPane::LogPane(const unsigned top, const unsigned rows, const size_t history)
+		: top_(top)
+		, rows_(rows)
+		, ring_(std::max<size_t>(history, 1))
+	{
+		Screen::get().reserve_rows(top_, rows_);
+		repaint();
+	}
+
+	LogPane::~LogPane()
+	{
+		auto& screen = Screen::get();
+		screen.reserve_rows(0, 0);
+		screen.invalidate();
+	}
+
+	void LogPane::append(const std::string_view line)
+	{
+		add(line, ConsoleColor(), false);
+	}
+
+	void LogPane::append(const std::string_view line, const ConsoleColor color)
+	{
+		add(line, color, true);
+	}
+
+	void LogPane::repaint()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (!TerminalInfo::get().is_styled())
+			return;
+
+		UncountedOutput uncounted;
+		OutputFrame frame;
+		paint_all(out());
+	}
+
+	size_t LogPane::size() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return count_;
+	}
+
+	void LogPane::add(const std::string_view text, const ConsoleColor color, const bool colored)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto& added = ring_[next_];
+		added.text.assign(text.data(), text.size());
+		added.color = color;
+		added.colored = colored;
+		next_ = (next_ + 1) % ring_.size();
+		count_ = std::min(count_ + 1, ring_.size());
+
+		auto& terminal = TerminalInfo::get();
+		if (!terminal.is_styled())
+		{ // Printed like any other output
+			OutputFrame frame;
+			auto& buf = out();
+			put_line(buf, added, ~0U);
+			buf.append('\n');
+			return;
+		}
+
+		UncountedOutput uncounted;
+		OutputFrame frame;
+		auto& buf = out();
+		if (terminal.get_generation() != generation_)
+		{ // The terminal was resized, so the band may have moved or reflowed
+			paint_all(buf);
+			return;
+		}
+
+		unsigned top, bottom, columns;
+		if (!get_area(top, bottom, columns))
+			return;
+
+		console_backend::save_cursor(buf);
+		console_backend::scroll_up(buf, top, bottom);
+		console_backend::move_cursor(buf, 0, bottom);
+		put_line(buf, added, columns);
+		console_backend::restore_cursor(buf);
+	}
+
+	bool LogPane::get_area(unsigned& top, unsigned& bottom, unsigned& columns) const
+	{
+		auto& terminal = TerminalInfo::get();
+		const auto screen_rows = terminal.get_rows();
+		columns = terminal.get_columns();
+		if (top_ >= screen_rows || rows_ == 0 || columns == 0)
+			return false;
+
+		top = top_;
+		bottom = rows_ >= screen_rows - top_ ? screen_rows - 1 : top_ + rows_ - 1;
+		return true;
+	}
+
+	void LogPane::paint_all(OutputBuffer& buf)
+	{
+		generation_ = TerminalInfo::get().get_generation();
+		unsigned top, bottom, columns;
+		if (!get_area(top, bottom, columns))
+			return;
+
+		const auto height = bottom - top + 1;
+		const auto shown = static_cast<unsigned>(std::min<size_t>(count_, height));
+		const auto first = (next_ + ring_.size() - shown) % ring_.size();
+
+		console_backend::save_cursor(buf);
+		for (unsigned row = 0; row < height; ++row)
+		{
+			console_backend::move_cursor(buf, 0, top + row);
+			if (row < height - shown)
+			{
+				buf.append(columns, ' ');
+				continue;
+			}
+
+			const auto& shown_line = ring_[(first + row - (height - shown)) % ring_.size()];
+			const auto width = put_line(buf, shown_line, columns);
+			if (width < columns)
+				buf.append(columns - width, ' ');
+		}
+		console_backend::restore_cursor(buf);
+	}
+
+	unsigned LogPane::put_line(OutputBuffer& buf, const line& l, const unsigned columns) const
+	{
+		if (l.colored)
+			console_backend::set_style(buf, l.color);
+		const auto width = append_clipped(buf, l.text, columns);
+		if (l.colored)
+			console_backend::reset_style(buf);
+		return width;
+	}
+} // namespace cons
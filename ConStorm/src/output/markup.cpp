@@ -0,0 +1,47 @@
+/*
+ Code by Drake Johnson
+*/
+#include "../../include/cons/output/markup.hpp"
+#include "../../include/cons/output/backend.hpp"
+
+namespace cons
+{
+	void detail::markup_apply_style(OutputBuffer& buf, const markup_change& change)
+	{
+		const auto& style = change.style;
+		if constexpr (console_backend::INLINE_STYLES)
+		{ // The sequence was built at compile time
+			if (style.is_default())
+			{
+				// The colors of a ConsoleColor do not turn bold off, so
+				// leaving bold is not held back for them to replace
+				if (markup_style::is_bold(buf.get_attributes()))
+					buf.reset_attributes();
+				else
+					buf.release_attributes();
+			}
+			else
+				buf.set_attributes(style.get_attribute_id(), change.get_sequence());
+		}
+		else
+		{ // Backends without escape sequences are given the colors instead
+			if (style.is_default())
+			{
+				console_backend::reset_style(buf);
+				return;
+			}
+
+			using color = ConsoleColor::color;
+			auto colors = console_backend::get_default_color();
+			if (style.fg != MARKUP_DEFAULT_COLOR)
+				colors.set_foreground_color(static_cast<color>(style.fg));
+			if (style.bg != MARKUP_DEFAULT_COLOR)
+				colors.set_background_color(static_cast<color>(style.bg));
+			if (style.bold)
+				colors.set_foreground_color(static_cast<color>(
+					static_cast<unsigned short>(colors.get_foreground_color())
+					| ConsoleColor::INTENSITY_BIT));
+			console_backend::set_style(buf, colors);
+		}
+	}
+} // namespace cons
@@ -0,0 +1,107 @@
+/*
+ Code by Drake Johnson
+*/
+#include <cons/output/println/styled_text.hpp>
+#include <cons/output/backend.hpp>
+
+namespace cons
+{
+	StyledText::StyledText(std::string text)
+		: text_(std::move(text))
+	{}
+
+	StyledText::StyledText(std::string text, const ConsoleColor color)
+		: text_(std::move(text))
+	{
+		add_run(0, text_.size(), color);
+	}
+
+	StyledText& StyledText::append(const std::string_view text)
+	{
+		text_.append(text.data(), text.size());
+		return *this;
+	}
+
+	StyledText& StyledText::append(const size_t count, const char ch)
+	{
+		text_.append(count, ch);
+		return *this;
+	}
+
+	StyledText& StyledText::append(const std::string_view text,
+		const ConsoleColor color)
+	{
+		add_run(text_.size(), text.size(), color);
+		text_.append(text.data(), text.size());
+		return *this;
+	}
+
+	StyledText& StyledText::append(const size_t count, const char ch,
+		const ConsoleColor color)
+	{
+		add_run(text_.size(), count, color);
+		text_.append(count, ch);
+		return *this;
+	}
+
+	StyledText& StyledText::append(const StyledText& other)
+	{
+		const auto base = text_.size();
+		text_.append(other.text_);
+		for (const auto& other_run : other.runs_)
+			add_run(base + other_run.offset, other_run.length, other_run.color);
+		return *this;
+	}
+
+	void StyledText::clear() noexcept
+	{
+		text_.clear();
+		runs_.clear();
+	}
+
+	void StyledText::add_run(const size_t offset, const size_t length,
+		const ConsoleColor color)
+	{
+		if (length == 0)
+			return;
+
+		if (!runs_.empty())
+		{
+			auto& last = runs_.back();
+			if (last.color == color && last.offset + last.length == offset)
+			{ // Continues the previous run
+				last.length += static_cast<std::uint32_t>(length);
+				return;
+			}
+		}
+
+		runs_.push_back({ static_cast<std::uint32_t>(offset),
+			static_cast<std::uint32_t>(length), color });
+	}
+
+	void formatter<StyledText>::format(OutputBuffer& buf, const StyledText& text)
+	{
+		const auto& str = text.get_text();
+		size_t pos = 0;
+
+		// The default colors are only restored before uncolored text, so
+		// adjacent runs change colors directly
+		for (const auto& text_run : text.get_runs())
+		{
+			if (text_run.offset > pos)
+			{
+				console_backend::reset_style(buf);
+				buf.append(str.data() + pos, text_run.offset - pos);
+			}
+
+			console_backend::set_style(buf, text_run.color);
+			buf.append(str.data() + text_run.offset, text_run.length);
+			pos = text_run.offset + text_run.length;
+		}
+
+		if (!text.get_runs().empty())
+			console_backend::reset_style(buf);
+		if (pos < str.size())
+			buf.append(str.data() + pos, str.size() - pos);
+	}
+} // namespace cons
@@ -2,6 +2,7 @@
  Code by Drake Johnson
 */
 #include <cons/output/println/textf.hpp>
+#include <cons/output/backend.hpp>
 
 namespace cons
 {
@@ -38,60 +39,73 @@ namespace cons
 
 	void textf::display() const
 	{
-		const auto old_attribs = setup_console();
-		std::cout << std::flush << text_;
-		restore_console(old_attribs);
+		// With an inline backend, the escape sequences travel with the text
+		// and the buffer skips a color which is already set. The Windows
+		// backend flushes around each change of console attributes.
+		OutputFrame frame;
+		display(out());
+	}
+
+	void textf::display(OutputBuffer& buf) const
+	{
+		setup_console(buf);
+		buf.append(text_);
+		restore_console(buf);
 	}
 
 	void textf::modify_color(const layer layer, const ConsoleColor color)
 	{
-		WORD new_win_color;
-		auto win_fg = static_cast<WORD>(color.get_foreground_color());
-		auto win_bg = static_cast<WORD>(color.get_background_color()) * 16;
+		using value_type = std::underlying_type_t<ConsoleColor::color>;
 
 		switch (layer)
 		{
 		case layer::foreground:
-			new_win_color = static_cast<WORD>(color.get_foreground_color());
-			win_fg |= new_win_color;
-			color_.set_foreground_color(static_cast<ConsoleColor::color>(win_fg));
+			color_.set_foreground_color(static_cast<ConsoleColor::color>(
+				static_cast<value_type>(color_.get_foreground_color())
+				| static_cast<value_type>(color.get_foreground_color())));
 			break;
 
 		case layer::background:
-			new_win_color = static_cast<WORD>(color.get_background_color()) * 16;
-			win_bg |= new_win_color;
-			color_.set_background_color(static_cast<ConsoleColor::color>(win_bg));
+			color_.set_background_color(static_cast<ConsoleColor::color>(
+				static_cast<value_type>(color_.get_background_color())
+				| static_cast<value_type>(color.get_background_color())));
 			break;
 
 		default:
 			throw InvalidConsoleLayerEnumValueException();
 		}
+		on_change();
 	}
 
 	void textf::reset_color()
 	{
 		color_.set_foreground_color(ConsoleColor::color::bright_white);
 		color_.set_background_color(ConsoleColor::color::black);
+		on_change();
 	}
 
 	void textf::set_text(std::string text)
 	{
 		text_ = std::move(text);
+		on_change();
 	}
 
 	void textf::set_color(const ConsoleColor color)
 	{
 		color_ = color;
+		on_change();
 	}
 
-	void textf::set_foreground_color(const ConsoleColor::color color)
+	void textf::set_foreground_color(const ConsoleColor::value color)
 	{
 		color_.set_foreground_color(color);
+		on_change();
 	}
 
-	void textf::set_background_color(const ConsoleColor::color color)
+	void textf::set_background_color(const ConsoleColor::value color)
 	{
 		color_.set_background_color(color);
+		on_change();
 	}
 
 	std::string textf::get_text() const
@@ -107,60 +121,32 @@ namespace cons
 	textf& textf::operator=(std::string str)
 	{
 		text_ = std::move(str);
+		on_change();
 		return *this;
 	}
 
-	WORD textf::get_win_color(const ConsoleColor color)
+	void textf::setup_console(OutputBuffer& buf) const
 	{
-		return static_cast<WORD>(color.get_foreground_color()) + 16 * 
-			static_cast<WORD>(color.get_background_color());
-	}
-
-	WORD textf::setup_console() const
-	{
-		HANDLE hout = GetStdHandle(STD_OUTPUT_HANDLE);
-		CONSOLE_SCREEN_BUFFER_INFO csbi;
-		WORD old_attrib = -1;
-
-		// Get console info
-		if (!GetConsoleScreenBufferInfo(hout, &csbi))
-			throw WindowsConsoleFailureException();
-
-		// Save old colors
-		old_attrib = csbi.wAttributes;
-
-		// Set new color
-		if (!SetConsoleTextAttribute(hout, get_win_color(color_)))
-			throw WindowsConsoleFailureException();
-
-		return old_attrib;
+		console_backend::set_style(buf, color_);
 	}
 
-	void textf::restore_console(const WORD old_attribs) const
+	void textf::restore_console(OutputBuffer& buf) const
 	{
-		try
-		{
-			// Set color back
-			if (!SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 
-				old_attribs))
-				throw WindowsConsoleFailureException();
-		}
-		catch (const WindowsConsoleFailureException& e)
-		{
-			println<decltype(e.what())> p(e.what());
-		}
+		console_backend::reset_style(buf);
 	}
 
 	void textf::copy(textf& dest, const textf& src) 
 	{
 		dest.text_ = src.text_;
 		dest.color_ = src.color_;
+		dest.on_change();
 	}
 
 	void textf::move(textf& dest, textf&& src) noexcept
 	{
 		dest.text_ = std::move(src.text_);
 		dest.color_ = src.color_;
+		dest.on_change();
 	}
 
 	InvalidConsoleLayerEnumValueException::InvalidConsoleLayerEnumValueException()
@@ -0,0 +1,131 @@
+/*
+ Code by Drake Johnson
+
+ Defines the RenderThread class
+*/
+#include <cons/output/render_thread.hpp>
+#include <cons/output/buffer.hpp>
+
+namespace
+{
+	std::atomic<cons::RenderThread*> s_active{ nullptr };
+} // namespace
+
+namespace cons
+{
+	RenderThread::RenderThread(const unsigned max_rate)
+		: interval_(max_rate == 0 ? std::chrono::steady_clock::duration::zero()
+			: std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+				std::chrono::seconds(1)) / max_rate)
+		, screen_(0, 0)
+		, renderer_(&RenderThread::run, this)
+	{
+		RenderThread* expected = nullptr;
+		s_active.compare_exchange_strong(expected, this);
+	}
+
+	RenderThread::~RenderThread()
+	{
+		RenderThread* expected = this;
+		const bool was_active = s_active.compare_exchange_strong(expected, nullptr);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+		}
+		work_cv_.notify_one();
+		renderer_.join();
+
+		// The terminal shows what this thread painted, not what the
+		// terminal's screen last presented itself
+		if (was_active)
+			Screen::get().invalidate();
+	}
+
+	RenderThread* RenderThread::get_active() noexcept
+	{
+		return s_active.load(std::memory_order_acquire);
+	}
+
+	void RenderThread::publish(Screen& screen)
+	{
+		auto& filled = slots_[back_];
+		screen.export_frame(filled.frame);
+		filled.sequence = published_.load(std::memory_order_relaxed) + 1;
+
+		// Rows invalidated by a frame which is skipped must still be
+		// repainted
+		auto invalid_from = invalid_from_.load();
+		while (filled.frame.valid_rows < invalid_from
+			&& !invalid_from_.compare_exchange_weak(invalid_from, filled.frame.valid_rows))
+		{}
+
+		back_ = middle_.exchange(back_ | FRESH) & INDEX;
+		published_.store(filled.sequence);
+		if (sleeping_.load())
+			wake_renderer();
+	}
+
+	void RenderThread::flush()
+	{
+		const auto sequence = published_.load();
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		urgent_.store(true);
+		work_cv_.notify_one();
+		progress_cv_.wait(lock, [this, sequence] { return painted_.load() >= sequence || stop_; });
+		urgent_.store(false);
+	}
+
+	void RenderThread::wake_renderer()
+	{
+		{ // Pairs with the predicate check in 'run()'
+			std::lock_guard<std::mutex> lock(mutex_);
+		}
+		work_cv_.notify_one();
+	}
+
+	void RenderThread::run()
+	{
+		auto next_paint = std::chrono::steady_clock::now();
+		for (;;)
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			sleeping_.store(true);
+			work_cv_.wait(lock, [this] { return stop_ || has_frame(); });
+			sleeping_.store(false);
+
+			// Frames published while the interval passes replace this one
+			work_cv_.wait_until(lock, next_paint, [this] { return stop_ || urgent_.load(); });
+			const bool stopping = stop_;
+			lock.unlock();
+
+			if (has_frame())
+			{
+				paint();
+				next_paint = std::chrono::steady_clock::now() + interval_;
+
+				lock.lock();
+				progress_cv_.notify_all();
+			}
+			if (stopping)
+				break;
+		}
+	}
+
+	void RenderThread::paint()
+	{
+		front_ = middle_.exchange(front_) & INDEX;
+		auto& taken = slots_[front_];
+		taken.frame.valid_rows = invalid_from_.exchange(~0U);
+
+		screen_.import_frame(taken.frame);
+		screen_.present();
+		OutputFrame::flush();
+		OutputFrame::sink().flush();
+
+		skipped_ += taken.sequence - painted_.load() - 1;
+		++paints_;
+		painted_.store(taken.sequence);
+	}
+} // namespace cons
@@ -0,0 +1,578 @@
+/*
+ Code by Drake Johnson
+
+ Defines the Screen class
+*/
+#include <cons/output/screen.hpp>
+#include <cons/output/backend.hpp>
+#include <cons/output/render_thread.hpp>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace
+{
+	// Asks the terminal to hold the frame and show it at once (mode 2026).
+	// Terminals without the mode ignore it.
+	constexpr std::string_view SYNC_BEGIN = "\x1b[?2026h";
+	constexpr std::string_view SYNC_END = "\x1b[?2026l";
+
+	// Roughly what clearing the screen and moving to each row costs, over
+	// writing the changed cells in place
+	constexpr size_t FULL_REPAINT_OVERHEAD = 8;
+
+	static_assert(sizeof(cons::screen_cell) == 2 * sizeof(std::uint32_t),
+		"Rows of cells are compared as bytes");
+
+	bool is_same_row(const cons::screen_cell* a, const cons::screen_cell* b, const unsigned columns) noexcept
+	{
+		return std::memcmp(a, b, columns * sizeof(cons::screen_cell)) == 0;
+	}
+
+	/**
+	 @returns The column from which the row holds only blanks
+	*/
+	unsigned get_blank_from(const cons::screen_cell* row, unsigned columns) noexcept
+	{
+		while (columns > 0 && row[columns - 1] == cons::screen_cell{ ' ', 0 })
+			--columns;
+		return columns;
+	}
+
+	/**
+	 @returns The number of bytes in the UTF-8 character starting with `lead`
+	*/
+	size_t get_utf8_size(const unsigned char lead) noexcept
+	{
+		if (lead < 0x80)
+			return 1;
+		if ((lead & 0xE0) == 0xC0)
+			return 2;
+		if ((lead & 0xF0) == 0xE0)
+			return 3;
+		if ((lead & 0xF8) == 0xF0)
+			return 4;
+		return 0; // A continuation byte, or not UTF-8
+	}
+} // namespace
+
+namespace cons
+{
+	Screen::Screen(const unsigned columns, const unsigned rows)
+		: columns_(columns)
+		, rows_(rows)
+		, front_(static_cast<size_t>(columns) * rows, BLANK)
+		, back_(static_cast<size_t>(columns) * rows, BLANK)
+		, styles_{ { 0, ConsoleColor(ConsoleColor::color::white, ConsoleColor::color::black) } }
+	{}
+
+	Screen& Screen::get()
+	{
+		static Screen s_screen = []
+		{
+			auto& terminal = TerminalInfo::get();
+			Screen screen(terminal.get_columns(), terminal.get_rows());
+			screen.follows_terminal_ = true;
+			screen.generation_ = terminal.get_generation();
+			return screen;
+		}();
+		return s_screen;
+	}
+
+	void Screen::begin_frame()
+	{
+		if (follows_terminal_)
+		{
+			auto& terminal = TerminalInfo::get();
+			const auto generation = terminal.get_generation();
+			if (generation != generation_)
+			{
+				generation_ = generation;
+				resize(terminal.get_columns(), terminal.get_rows());
+			}
+		}
+
+		back_.assign(static_cast<size_t>(columns_) * rows_, BLANK);
+		used_rows_ = 0;
+		cursor_x_ = 0;
+		cursor_y_ = 0;
+		compact_styles();
+	}
+
+	unsigned Screen::write(const unsigned x, const unsigned y, const std::string_view text)
+	{
+		return write_cells(x, y, text, 0);
+	}
+
+	unsigned Screen::write(const unsigned x, const unsigned y, const std::string_view text,
+		const ConsoleColor color)
+	{
+		return write_cells(x, y, text, get_style(color));
+	}
+
+	unsigned Screen::write(unsigned x, const unsigned y, const StyledText& text)
+	{
+		const std::string_view str = text.get_text();
+		size_t pos = 0;
+		for (const auto& text_run : text.get_runs())
+		{
+			x = write_cells(x, y, str.substr(pos, text_run.offset - pos), 0);
+			x = write_cells(x, y, str.substr(text_run.offset, text_run.length),
+				get_style(text_run.color));
+			pos = text_run.offset + text_run.length;
+		}
+		return write_cells(x, y, str.substr(pos), 0);
+	}
+
+	unsigned Screen::draw(const unsigned row, const Header& header)
+	{
+		const auto location = header.get_console_cursor();
+		const auto x = location.X < columns_ ? location.X : 0U;
+		const auto end = write(x, row, header.get_text(), header.get_color());
+		write(x, row + 1, std::string(end - x + 2, '-'), header.get_color());
+		return row + 2;
+	}
+
+	unsigned Screen::draw(unsigned row, const WordWrap& text)
+	{
+		if (text.get_styled_lines().empty())
+		{
+			for (const auto& line : text.get_lines())
+				write(0, row++, line);
+		}
+		else
+		{
+			for (const auto& line : text.get_styled_lines())
+				write(0, row++, line);
+		}
+		return row;
+	}
+
+	void Screen::set_cursor(const unsigned x, const unsigned y) noexcept
+	{
+		cursor_x_ = x;
+		cursor_y_ = y;
+	}
+
+	void Screen::present()
+	{
+		if (follows_terminal_)
+		{
+			if (auto* renderer = RenderThread::get_active())
+			{ // The render thread owns the terminal
+				renderer->publish(*this);
+				return;
+			}
+		}
+
+		OutputFrame frame;
+		auto& buf = out();
+
+		// Anything printed since the last frame is somewhere on the screen
+		if (get_output_position() != output_mark_)
+			invalidate();
+
+		const bool styled = TerminalInfo::get().is_styled();
+		const auto height = std::max(used_rows_, cursor_y_ + 1);
+		buf.commit_reset();
+		const auto begin = buf.size();
+		if (!styled || height > rows_)
+			present_lines(buf, styled);
+		else
+			present_changes(buf);
+
+		// Unstyled frames are plain lines already, and a frame which changed
+		// nothing is not repeated
+		if (styled && buf.size() != begin && OutputFrame::sink().keeps_transcript())
+		{
+			const auto split = buf.size();
+			write_lines(buf, false);
+			buf.append('\n');
+			buf.add_transcript_frame(begin, split);
+		}
+
+		output_mark_ = get_output_position();
+	}
+
+	void Screen::invalidate() noexcept
+	{
+		valid_rows_ = 0;
+	}
+
+	void Screen::invalidate_after_input(const unsigned lines) noexcept
+	{
+		if (cursor_y_ + lines >= rows_)
+			invalidate(); // The terminal scrolled
+		else
+			valid_rows_ = std::min(valid_rows_, cursor_y_);
+	}
+
+	void Screen::resize(const unsigned columns, const unsigned rows)
+	{
+		columns_ = columns;
+		rows_ = rows;
+		front_.assign(static_cast<size_t>(columns) * rows, BLANK);
+		back_.assign(static_cast<size_t>(columns) * rows, BLANK);
+		used_rows_ = 0;
+		invalidate();
+	}
+
+	void Screen::reserve_rows(const unsigned top, const unsigned count) noexcept
+	{
+		reserved_top_ = top;
+		reserved_end_ = count > ALL_ROWS - top ? ALL_ROWS : top + count;
+	}
+
+	void Screen::export_frame(ScreenFrame& frame)
+	{
+		frame.columns = columns_;
+		frame.rows = rows_;
+		frame.used_rows = used_rows_;
+		frame.cursor_x = cursor_x_;
+		frame.cursor_y = cursor_y_;
+		frame.valid_rows = valid_rows_;
+		frame.reserved_top = reserved_top_;
+		frame.reserved_end = reserved_end_;
+		frame.cells.assign(back_.begin(), back_.end());
+
+		frame.colors.clear();
+		for (const auto& s : styles_)
+			frame.colors.push_back(s.color);
+		valid_rows_ = rows_;
+	}
+
+	void Screen::import_frame(const ScreenFrame& frame)
+	{
+		if (frame.columns != columns_ || frame.rows != rows_)
+			resize(frame.columns, frame.rows);
+		compact_styles();
+
+		// The frame's style indices are its own, so they are mapped to this
+		// screen's
+		remapped_styles_.clear();
+		remapped_styles_.push_back(0);
+		for (size_t i = 1; i < frame.colors.size(); ++i)
+			remapped_styles_.push_back(get_style(frame.colors[i]));
+
+		back_.resize(frame.cells.size());
+		for (size_t i = 0; i < frame.cells.size(); ++i)
+			back_[i] = { frame.cells[i].glyph, remapped_styles_[frame.cells[i].style] };
+
+		used_rows_ = frame.used_rows;
+		cursor_x_ = frame.cursor_x;
+		cursor_y_ = frame.cursor_y;
+		valid_rows_ = std::min(valid_rows_, frame.valid_rows);
+		reserved_top_ = frame.reserved_top;
+		reserved_end_ = frame.reserved_end;
+	}
+
+	std::uint32_t Screen::get_style(const ConsoleColor color)
+	{
+		const auto attributes = ConsoleColor::get_attribute_id(color);
+		const auto [it, inserted] = style_ids_.emplace(attributes,
+			static_cast<std::uint32_t>(styles_.size()));
+		if (inserted)
+			styles_.push_back({ attributes, color });
+		return it->second;
+	}
+
+	void Screen::compact_styles()
+	{
+		if (styles_.size() <= MAX_STYLES)
+			return;
+
+		// The front buffer's cells are renumbered, so the next frame is
+		// still compared with what the terminal shows
+		std::vector<std::uint32_t> renumbered(styles_.size(), 0);
+		std::vector<style> kept{ styles_[0] };
+		style_ids_.clear();
+		for (auto& c : front_)
+		{
+			if (c.style == 0)
+				continue;
+
+			auto& index = renumbered[c.style];
+			if (index == 0)
+			{
+				index = static_cast<std::uint32_t>(kept.size());
+				kept.push_back(styles_[c.style]);
+				style_ids_.emplace(kept.back().attributes, index);
+			}
+			c.style = index;
+		}
+		styles_ = std::move(kept);
+	}
+
+	unsigned Screen::write_cells(unsigned x, const unsigned y, const std::string_view text,
+		const std::uint32_t style)
+	{
+		if (y >= used_rows_)
+		{ // Rows past the bottom are kept, to be written by 'present_lines()'
+			used_rows_ = y + 1;
+			if (used_rows_ > rows_)
+				back_.resize(static_cast<size_t>(columns_) * used_rows_, BLANK);
+		}
+
+		auto* row = back_.data() + static_cast<size_t>(y) * columns_;
+		for (size_t i = 0; i < text.size() && x < columns_; ++x)
+		{
+			const auto lead = static_cast<unsigned char>(text[i]);
+			auto size = get_utf8_size(lead);
+
+			std::uint32_t glyph = ' ';
+			if (size == 0 || i + size > text.size() || lead < 0x20 || lead == 0x7F)
+				size = 1;
+			else
+			{
+				glyph = 0;
+				for (size_t byte = 0; byte < size; ++byte)
+					glyph |= static_cast<std::uint32_t>(static_cast<unsigned char>(text[i + byte])) << 8 * byte;
+			}
+
+			row[x] = { glyph, style };
+			i += size;
+		}
+		return x;
+	}
+
+	void Screen::present_changes(OutputBuffer& buf)
+	{
+		const auto cells = static_cast<std::ptrdiff_t>(columns_) * rows_;
+		if (valid_rows_ == rows_ && cursor_x_ == shown_cursor_x_ && cursor_y_ == shown_cursor_y_
+			&& std::equal(back_.begin(), back_.begin() + cells, front_.begin()))
+			return; // Nothing changed
+
+		if (valid_rows_ == rows_ && reserved_top_ == reserved_end_ && is_repaint_shorter())
+			valid_rows_ = 0;
+
+		// Backends which write escape sequences have them chosen by the
+		// encoder; the others are only given absolute moves
+		constexpr bool inline_output = console_backend::INLINE_STYLES;
+		const auto& encoder = UpdateEncoder::get();
+		if constexpr (inline_output)
+			buf.append(SYNC_BEGIN);
+
+		// Where the terminal's cursor is. Unknown until the first move, since
+		// input may have moved it.
+		UpdateEncoder::position term{ UpdateEncoder::UNKNOWN, UpdateEncoder::UNKNOWN };
+		std::uint32_t current_style = 0;
+
+		const auto reserved_end = std::min(reserved_end_, rows_);
+		if (valid_rows_ < rows_ && reserved_top_ < reserved_end && valid_rows_ < reserved_end)
+		{ // The reserved rows must not be cleared, so the rows above them are
+		  // overwritten in full, and only the rows below them are cleared
+			const auto row_start = [this](const unsigned y)
+			{
+				return front_.begin() + static_cast<std::ptrdiff_t>(y) * columns_;
+			};
+			if (valid_rows_ < reserved_top_)
+				std::fill(row_start(valid_rows_), row_start(reserved_top_), UNKNOWN);
+			if (reserved_end < rows_)
+			{
+				console_backend::move_cursor(buf, 0, reserved_end);
+				console_backend::clear_below(buf);
+				std::fill(row_start(reserved_end), row_start(rows_), BLANK);
+				term = { 0, reserved_end };
+			}
+		}
+		else if (valid_rows_ < rows_)
+		{
+			if (valid_rows_ == 0)
+				console_backend::clear(buf);
+			else
+			{
+				console_backend::move_cursor(buf, 0, valid_rows_);
+				console_backend::clear_below(buf);
+			}
+			std::fill(front_.begin() + static_cast<std::ptrdiff_t>(valid_rows_) * columns_,
+				front_.end(), BLANK);
+			term = { 0, valid_rows_ };
+		}
+
+		const auto move_to = [&](const unsigned x, const unsigned y)
+		{
+			if (term.x == x && term.y == y)
+				return;
+			if constexpr (inline_output)
+				encoder.move(buf, term, { x, y }, front_.data() + static_cast<size_t>(y) * columns_,
+					current_style);
+			else
+				console_backend::move_cursor(buf, x, y);
+			term = { x, y };
+		};
+
+		for (unsigned y = 0; y < rows_; ++y)
+		{
+			const auto* back_row = back_.data() + static_cast<size_t>(y) * columns_;
+			auto* front_row = front_.data() + static_cast<size_t>(y) * columns_;
+
+			if (is_reserved(y) || is_same_row(back_row, front_row, columns_))
+				continue;
+
+			// The back row is blank from here to its end
+			const auto blank_from = get_blank_from(back_row, columns_);
+			unsigned x = 0;
+			while (x < columns_)
+			{
+				while (x < columns_ && back_row[x] == front_row[x])
+					++x;
+				if (x == columns_)
+					break;
+
+				if (inline_output && x >= blank_from)
+				{ // Only blanks are left to write; erasing the row may be shorter
+					auto last = columns_ - 1;
+					while (front_row[last] == BLANK)
+						--last;
+					const auto blanks = last - x + 1;
+					if (encoder.get_erase_cost() < std::min(blanks, encoder.get_repeat_cost(blanks)))
+					{
+						move_to(x, y);
+						console_backend::reset_style(buf);
+						current_style = 0;
+						encoder.erase_line(buf); // Commits the reset first
+						std::fill(front_row + x, front_row + columns_, BLANK);
+						break;
+					}
+				}
+
+				// The blanks at the end of the row are a run of their own, so
+				// they may be erased
+				const auto limit = x < blank_from ? blank_from : columns_;
+				auto end = x + 1;
+				while (end < limit && back_row[end] != front_row[end])
+					++end;
+
+				move_to(x, y);
+				while (x < end)
+				{ // Runs of one character may be repeated rather than written
+					const auto c = back_row[x];
+					unsigned count = 1;
+					while (x + count < end && back_row[x + count] == c)
+						++count;
+
+					apply_style(buf, c.style, current_style);
+					if (inline_output && count > 1 && c.glyph < 0x80
+						&& encoder.get_repeat_cost(count) < count)
+						encoder.repeat(buf, static_cast<char>(c.glyph), count);
+					else
+					{
+						for (unsigned i = 0; i < count; ++i)
+							UpdateEncoder::put_glyph(buf, c.glyph);
+					}
+					std::fill(front_row + x, front_row + x + count, c);
+					x += count;
+				}
+
+				// A character in the last column leaves the cursor waiting to
+				// wrap, which terminals handle differently
+				term = end < columns_ ? UpdateEncoder::position{ end, y }
+					: UpdateEncoder::position{ UpdateEncoder::UNKNOWN, UpdateEncoder::UNKNOWN };
+			}
+		}
+
+		console_backend::reset_style(buf);
+		current_style = 0;
+		move_to(std::min(cursor_x_, columns_ - 1), cursor_y_);
+		buf.reset_attributes();
+		shown_cursor_x_ = cursor_x_;
+		shown_cursor_y_ = cursor_y_;
+
+		if constexpr (inline_output)
+			buf.append(SYNC_END);
+		valid_rows_ = rows_;
+	}
+
+	bool Screen::is_repaint_shorter() const
+	{
+		size_t changed = 0;
+		for (unsigned y = 0; y < rows_; ++y)
+		{
+			const auto* back_row = back_.data() + static_cast<size_t>(y) * columns_;
+			const auto* front_row = front_.data() + static_cast<size_t>(y) * columns_;
+			if (!is_same_row(back_row, front_row, columns_))
+			{
+				for (unsigned x = 0; x < columns_; ++x)
+					changed += back_row[x] != front_row[x];
+			}
+		}
+
+		// Stops once the repaint is known to be longer, which is usually on
+		// the first row
+		size_t drawn = FULL_REPAINT_OVERHEAD;
+		for (unsigned y = 0; y < rows_ && drawn < changed; ++y)
+			drawn += get_blank_from(back_.data() + static_cast<size_t>(y) * columns_, columns_);
+		return drawn < changed;
+	}
+
+	void Screen::present_lines(OutputBuffer& buf, const bool styled)
+	{
+		if (styled)
+			console_backend::clear(buf);
+
+		write_lines(buf, styled);
+
+		// The frame scrolled, or has no cursor to place, so what the
+		// terminal shows is unknown
+		if (styled)
+			invalidate();
+	}
+
+	void Screen::write_lines(OutputBuffer& buf, const bool styled) const
+	{
+		const auto height = std::max(used_rows_, cursor_y_ + 1);
+		std::uint32_t current_style = 0;
+		for (unsigned y = 0; y < height; ++y)
+		{
+			if (y > 0)
+				buf.append('\n');
+			if (y >= used_rows_)
+				continue;
+
+			// Trailing blanks are left off, except up to the cursor
+			const auto* row = back_.data() + static_cast<size_t>(y) * columns_;
+			auto width = columns_;
+			while (width > 0 && row[width - 1] == BLANK)
+				--width;
+			if (y == cursor_y_)
+				width = std::max(width, std::min(cursor_x_, columns_));
+
+			if (!styled)
+			{
+				for (unsigned x = 0; x < width; ++x)
+					UpdateEncoder::put_glyph(buf, row[x].glyph);
+				continue;
+			}
+
+			for (unsigned x = 0; x < width; ++x)
+				put_cell(buf, row[x], current_style);
+			console_backend::reset_style(buf);
+			current_style = 0;
+		}
+		buf.reset_attributes();
+	}
+
+	void Screen::put_cell(OutputBuffer& buf, const screen_cell c, std::uint32_t& current_style) const
+	{
+		apply_style(buf, c.style, current_style);
+		UpdateEncoder::put_glyph(buf, c.glyph);
+	}
+
+	void Screen::apply_style(OutputBuffer& buf, const std::uint32_t style,
+		std::uint32_t& current_style) const
+	{
+		if (style == current_style)
+			return;
+
+		if (style == 0)
+			console_backend::reset_style(buf);
+		else
+			console_backend::set_style(buf, styles_[style].color);
+		current_style = style;
+	}
+
+	size_t Screen::get_output_position()
+	{
+		return get_bytes_written() + out().get_terminal_size();
+	}
+} // namespace cons
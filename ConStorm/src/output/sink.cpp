@@ -0,0 +1,144 @@
+/*
+ Code by Drake Johnson
+*/
+#include "../../include/cons/output/sink.hpp"
+#include "../../include/cons/output/backend.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif // !WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#   include <io.h>
+#else // Assuming Unix
+#   include <cerrno>
+#   include <unistd.h>
+#endif // _WIN32
+
+namespace
+{
+	std::atomic<cons::OutputSink*> s_output_sink{ nullptr };
+
+	/**
+	 Writes the whole range to a file descriptor, retrying partial writes
+	*/
+	void write_fd(const int fd, const char* data, size_t size)
+	{
+		while (size > 0)
+		{
+#ifdef _WIN32
+			const auto written = _write(fd, data, static_cast<unsigned>(size));
+			if (written < 0)
+				return;
+#else // Assuming Unix
+			const auto written = ::write(fd, data, size);
+			if (written < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				return;
+			}
+#endif // _WIN32
+			data += written;
+			size -= static_cast<size_t>(written);
+		}
+	}
+} // namespace
+
+namespace cons
+{
+	void StdoutSink::write(const char* data, size_t size)
+	{
+		// Anything written to std::cout directly must reach the console first
+		std::cout.flush();
+
+#ifdef _WIN32
+		const auto hout = GetStdHandle(STD_OUTPUT_HANDLE);
+		while (size > 0)
+		{
+			DWORD written = 0;
+			if (!WriteFile(hout, data, static_cast<DWORD>(size), &written, nullptr))
+				return;
+			data += written;
+			size -= written;
+		}
+#else // Assuming Unix
+		write_fd(STDOUT_FILENO, data, size);
+#endif // _WIN32
+	}
+
+	void FdSink::write(const char* data, const size_t size)
+	{
+		write_fd(fd_, data, size);
+	}
+
+	MemorySink::MemorySink(const size_t capacity)
+	{
+		data_.reserve(capacity);
+	}
+
+	void MemorySink::write(const char* data, const size_t size)
+	{
+		data_.append(data, size);
+	}
+
+	void NullSink::write(const char*, const size_t size)
+	{
+		bytes_ += size;
+		++writes_;
+	}
+
+	TeeSink::TeeSink(const std::initializer_list<OutputSink*> sinks)
+		: sinks_(sinks)
+	{}
+
+	void TeeSink::write(const char* data, const size_t size)
+	{
+		for (const auto sink : sinks_)
+			sink->write(data, size);
+	}
+
+	void TeeSink::write_frames(const std::string_view terminal, const std::string_view transcript)
+	{
+		for (const auto sink : sinks_)
+			sink->write_frames(terminal, transcript);
+	}
+
+	void TeeSink::flush()
+	{
+		for (const auto sink : sinks_)
+			sink->flush();
+	}
+
+	bool TeeSink::keeps_transcript() const
+	{
+		return std::any_of(sinks_.begin(), sinks_.end(),
+			[](const OutputSink* const sink) { return sink->keeps_transcript(); });
+	}
+
+	void TeeSink::add_sink(OutputSink& sink)
+	{
+		sinks_.push_back(&sink);
+	}
+
+	void TeeSink::remove_sink(const OutputSink& sink)
+	{
+		sinks_.erase(
+			std::remove(sinks_.begin(), sinks_.end(), &sink), 
+			sinks_.end()
+		);
+	}
+
+	void set_output_sink(OutputSink* const sink)
+	{
+		s_output_sink.store(sink);
+	}
+
+	OutputSink& get_output_sink()
+	{
+		const auto sink = s_output_sink.load();
+		return sink != nullptr ? *sink : console_backend::get_sink();
+	}
+} // namespace cons
@@ -3,6 +3,168 @@
 */
 #include "../../include/cons/output/word_wrap.hpp"
 
+namespace
+{
+	/**
+	 Appends characters of the original string to a plain line
+	*/
+	struct plain_fill
+	{
+		void operator()(std::string& line, const size_t count, const char ch,
+			size_t) const
+		{
+			line.append(count, ch);
+		}
+	};
+
+	/**
+	 Appends characters of the original string to a styled line, in the color
+	 of the character of the original string at `index`. Indices must not
+	 decrease from one call to the next.
+	*/
+	class styled_fill
+	{
+	public:
+		explicit styled_fill(const cons::StyledText& text)
+			: runs_(text.get_runs())
+		{}
+
+		void operator()(cons::StyledText& line, const size_t count,
+			const char ch, const size_t index)
+		{
+			while (run_ < runs_.size() &&
+				runs_[run_].offset + runs_[run_].length <= index)
+				++run_;
+
+			if (run_ < runs_.size() && runs_[run_].offset <= index)
+				line.append(count, ch, runs_[run_].color);
+			else
+				line.append(count, ch);
+		}
+
+	private:
+		const std::vector<cons::StyledText::run>& runs_;
+		size_t run_ = 0;
+	};
+
+	template <class LineTy, class FillTy>
+	/**
+	 Wraps `str` into lines of at most `line_limit` characters, or the
+	 terminal's width for TERMINAL_WIDTH. `whole` is `str` as a line, which
+	 is used as-is when it already fits. Every other line is built by
+	 `fill`, which appends characters of `str` to a line.
+	*/
+	void wrap_lines(const std::string& str, unsigned line_limit,
+		const unsigned tab_spaces, const LineTy& whole,
+		std::deque<LineTy>& wrapped, FillTy& fill)
+	{
+		if (line_limit == cons::WordWrap::TERMINAL_WIDTH)
+			line_limit = cons::TerminalInfo::get().get_columns();
+
+		if (str.size() <= line_limit)
+		{
+			wrapped.push_back(whole);
+			return;
+		}
+
+		static const std::unordered_set<char> delims{ ' ', '\n', '\t' };
+		//static const std::unordered_set<char> punct{
+		//	'.', ',', '?', '!', ':', ';', '-', '\'', '\"', '/', '\\'
+		//};
+
+		LineTy cur_token;
+		LineTy cur_line;
+
+		// Build a token, then try to add it to the current line. If the current
+		// line can't fit the token, flush the current line to all_lines, reset
+		// the current line, and then add the current token
+		for (size_t i = 0; i < str.size(); ++i)
+		{
+			const auto ch = str[i];
+			if (delims.find(ch) != std::end(delims))
+			{ // Character is a delim
+				// If the character is a space, see if the weak token can fit
+				// on the current line (including the space). If not, move to
+				// a new line
+				if (ch == ' ')
+				{
+					if (cur_line.size() + cur_token.size() + 1 <= line_limit)
+					{ // Size with new token is fine, add to current line
+						cur_line.append(cur_token);
+						fill(cur_line, 1, ' ', i);
+					}
+					else
+					{ // Size with new token is too big, flush current line
+						wrapped.push_back(std::move(cur_line));
+						cur_line.clear();
+						cur_line.append(cur_token);
+						fill(cur_line, 1, ' ', i);
+					}
+				}
+				else if (ch == '\n')
+				{
+					cur_line.append(cur_token);
+					wrapped.push_back(std::move(cur_line));
+					cur_line.clear();
+				}
+				else if (ch == '\t')
+				{
+					if (cur_line.size() + cur_token.size() + tab_spaces <= line_limit)
+					{ // Size with new token is fine, add to current line
+						cur_line.append(cur_token);
+						fill(cur_line, tab_spaces, ' ', i);
+					}
+					else if (cur_line.size() + cur_token.size() <= line_limit)
+					{ // Size with new token plus tab is too large, move tab to new line
+						cur_line.append(cur_token);
+						wrapped.push_back(std::move(cur_line));
+						cur_line.clear();
+						fill(cur_line, tab_spaces, ' ', i);
+					}
+					else
+					{ // The current token without the tab is too large
+						wrapped.push_back(std::move(cur_line));
+						cur_line.clear();
+						cur_line.append(cur_token);
+						fill(cur_line, tab_spaces, ' ', i);
+					}
+				}
+
+				// Always clear current token when delim reached
+				cur_token.clear();
+			}
+			else
+			{ // Normal character, so try to add it
+				// If the current token (plus a hyphen) here is bigger than the
+				// line allowance, that means the current token itself is 
+				// bigger than the line allowance and must be broken up and 
+				// hyphenated
+				if (cur_token.size() + 2 > line_limit)
+				{ // Flush and reset the current token
+					fill(cur_token, 1, ch, i);
+					fill(cur_token, 1, '-', i);
+					wrapped.push_back(std::move(cur_token));
+					cur_token.clear();
+				}
+				else
+					fill(cur_token, 1, ch, i);
+			}
+		}
+
+		// Flush final token
+		if (cur_line.size() + cur_token.size() <= line_limit)
+		{
+			cur_line.append(cur_token);
+			wrapped.push_back(std::move(cur_line));
+		}
+		else
+		{
+			wrapped.push_back(std::move(cur_line));
+			wrapped.push_back(std::move(cur_token));
+		}
+	}
+} // namespace
+
 namespace cons
 {
 	WordWrap::WordWrap(std::string orig_str, const unsigned char_count, 
@@ -18,6 +180,17 @@ namespace cons
 		: WordWrap(std::string(orig_str), char_count, tab_spaces)
 	{}
 
+	WordWrap::WordWrap(const StyledText& orig_str, const unsigned char_count,
+		const unsigned tab_spaces)
+		: orig_str_(orig_str.get_text()), line_limit_(char_count)
+		, tab_spaces_(tab_spaces)
+	{
+		styled_fill fill(orig_str);
+		wrap_lines(orig_str_, line_limit_, tab_spaces_, orig_str, styled_, fill);
+		for (const auto& line : styled_)
+			wrapped_.push_back(line.get_text());
+	}
+
 	WordWrap& WordWrap::operator=(const WordWrap& other)
 	{
 		if (this != &other)
@@ -26,6 +199,7 @@ namespace cons
 			line_limit_ = other.line_limit_;
 			tab_spaces_ = other.tab_spaces_;
 			wrapped_ = other.wrapped_;
+			styled_ = other.styled_;
 		}
 		return *this;
 	}
@@ -33,6 +207,7 @@ namespace cons
 	WordWrap& WordWrap::operator=(const std::string& other)
 	{
 		orig_str_ = other;
+		styled_.clear();
 		wrap();
 		return *this;
 	}
@@ -42,6 +217,7 @@ namespace cons
 		, line_limit_(other.line_limit_)
 		, tab_spaces_(other.tab_spaces_)
 		, wrapped_(std::move(other.wrapped_))
+		, styled_(std::move(other.styled_))
 	{}
 
 	WordWrap& WordWrap::operator=(WordWrap&& other) noexcept
@@ -52,6 +228,7 @@ namespace cons
 			line_limit_ = other.line_limit_;
 			tab_spaces_ = other.tab_spaces_;
 			wrapped_ = std::move(other.wrapped_);
+			styled_ = std::move(other.styled_);
 		}
 		return *this;
 	}
@@ -59,6 +236,7 @@ namespace cons
 	WordWrap& WordWrap::operator=(std::string&& other) noexcept
 	{
 		orig_str_ = std::move(other);
+		styled_.clear();
 		try
 		{
 			wrap();
@@ -86,104 +264,16 @@ namespace cons
 
 	void WordWrap::wrap()
 	{
-		if (orig_str_.size() <= line_limit_)
-		{
-			wrapped_.push_back(orig_str_);
-			return;
-		}
-
-		static const std::unordered_set<char> delims{ ' ', '\n', '\t' };
-		//static const std::unordered_set<char> punct{
-		//	'.', ',', '?', '!', ':', ';', '-', '\'', '\"', '/', '\\'
-		//};
-
-		std::string cur_token;
-		std::string cur_line;
+		plain_fill fill;
 		wrapped_.clear();
-
-		// Build a token, then try to add it to the current line. If the current
-		// line can't fit the token, flush the current line to all_lines, reset
-		// the current line, and then add the current token
-		for (const auto& ch : orig_str_)
-		{
-			if (delims.find(ch) != std::end(delims))
-			{ // Character is a delim
-				// If the character is a space, see if the weak token can fit
-				// on the current line (including the space). If not, move to
-				// a new line
-				if (ch == ' ')
-				{
-					if ((cur_line + cur_token + ' ').size() <= line_limit_)
-					{ // Size with new token is fine, add to current line
-						cur_line += cur_token + ' ';
-					}
-					else
-					{ // Size with new token is too big, flush current line
-						wrapped_.push_back(cur_line);
-						cur_line.clear();
-						cur_line += cur_token + ' ';
-					}
-				}
-				else if (ch == '\n')
-				{
-					cur_line += cur_token;
-					wrapped_.push_back(cur_line);
-					cur_line.clear();
-				}
-				else if (ch == '\t')
-				{
-					std::string tab(tab_spaces_, ' ');
-					if ((cur_line + cur_token + tab).size() <= line_limit_)
-					{ // Size with new token is fine, add to current line
-						cur_line += cur_token + tab;
-					}
-					else if ((cur_line + cur_token).size() <= line_limit_)
-					{ // Size with new token plus tab is too large, move tab to new line
-						cur_line += cur_token;
-						wrapped_.push_back(cur_line);
-						cur_line.clear();
-						cur_line += tab;
-					}
-					else
-					{ // The current token without the tab is too large
-						wrapped_.push_back(cur_line);
-						cur_line.clear();
-						cur_line += cur_token + tab;
-					}
-				}
-
-				// Always clear current token when delim reached
-				cur_token.clear();
-			}
-			else
-			{ // Normal character, so try to add it
-				// If the current token (plus a hyphen) here is bigger than the
-				// line allowance, that means the current token itself is 
-				// bigger than the line allowance and must be broken up and 
-				// hyphenated
-				if ((cur_token + ch).size() + 1 > line_limit_)
-				{ // Flush and reset the current token
-					wrapped_.push_back(cur_token + ch + '-');
-					cur_token.clear();
-				}
-				else
-					cur_token += ch;
-			}
-		}
-
-		// Flush final token
-		if ((cur_line + cur_token).size() <= line_limit_)
-			wrapped_.push_back(cur_line + cur_token);
-		else
-		{
-			wrapped_.push_back(cur_line);
-			wrapped_.push_back(cur_token);
-		}
+		wrap_lines(orig_str_, line_limit_, tab_spaces_, orig_str_, wrapped_, fill);
 	}
 
-	println<WordWrap, void>::println(const WordWrap& lines)
+	void formatter<WordWrap, void>::format(OutputBuffer& buf, const WordWrap& lines)
 	{
-		auto deque = lines.get_deque();
-		println<decltype(deque)> p(deque);
+		if (lines.get_styled_lines().empty())
+			format_to(buf, lines.get_lines());
+		else
+			format_to(buf, lines.get_styled_lines());
 	}
 } // namespace cons
@@ -4,9 +4,164 @@
  Defines the ConsoleColor class
 */
 #include <cons/utilities/console/color.hpp>
+#include <cons/utilities/console/quantize.hpp>
+#include <cons/utilities/console/terminal.hpp>
+#include <array>
+#include <cstring>
+
+namespace
+{
+	using cons::ConsoleColor;
+
+	/**
+	 A piece of an escape sequence. Pieces are copied whole and the output
+	 then advanced by `size`, so the copy has a constant length.
+	*/
+	template <size_t N>
+	struct sgr_piece
+	{
+		char data[N] = {};
+		unsigned char size = 0;
+
+		constexpr void push(const char ch) { data[size++] = ch; }
+
+		constexpr void push(const unsigned n)
+		{
+			if (n >= 100)
+				push(static_cast<char>('0' + n / 100));
+			if (n >= 10)
+				push(static_cast<char>('0' + n / 10 % 10));
+			push(static_cast<char>('0' + n % 10));
+		}
+	};
+
+	template <size_t N, class MakeTy>
+	constexpr std::array<sgr_piece<N>, 256> make_table(MakeTy make)
+	{
+		std::array<sgr_piece<N>, 256> table{};
+		for (unsigned i = 0; i < table.size(); ++i)
+			table[i] = make(i);
+		return table;
+	}
+
+	/**
+	 The SGR parameter of a basic color; `base` is 30 for the foreground and
+	 40 for the background
+	*/
+	constexpr unsigned basic_parameter(const unsigned bits, const unsigned base)
+	{
+		return ((bits & ConsoleColor::INTENSITY_BIT) ? base + 60 : base)
+			+ ConsoleColor::get_ansi_color_number(static_cast<unsigned short>(bits));
+	}
+
+	/**
+	 The decimal digits of 0 to 255
+	*/
+	constexpr auto s_decimal = make_table<4>([](const unsigned i)
+	{
+		sgr_piece<4> piece;
+		piece.push(i);
+		return piece;
+	});
+
+	/**
+	 The whole sequence for every pair of basic colors. The index of a pair
+	 is its Windows console color value.
+	*/
+	constexpr auto s_basic_pairs = make_table<16>([](const unsigned i)
+	{
+		sgr_piece<16> piece;
+		piece.push('\x1b');
+		piece.push('[');
+		piece.push(basic_parameter(i & 0xF, 30));
+		piece.push(';');
+		piece.push(basic_parameter(i >> 4, 40));
+		piece.push('m');
+		return piece;
+	});
+
+	/**
+	 The parameter of each basic color, for the foreground (first 16
+	 entries) and the background (next 16)
+	*/
+	constexpr auto s_basic_layers = make_table<4>([](const unsigned i)
+	{
+		sgr_piece<4> piece;
+		if (i < 32)
+			piece.push(basic_parameter(i & 0xF, i < 16 ? 30 : 40));
+		return piece;
+	});
+
+	template <size_t N>
+	char* put(char* out, const sgr_piece<N>& piece) noexcept
+	{
+		std::memcpy(out, piece.data, N);
+		return out + piece.size;
+	}
+
+	char* put(char* out, const std::string_view str) noexcept
+	{
+		std::memcpy(out, str.data(), str.size());
+		return out + str.size();
+	}
+
+	/**
+	 Writes the parameters which set one layer of a color
+	*/
+	char* put_layer(char* out, const ConsoleColor::value layer,
+		const bool background) noexcept
+	{
+		const auto payload = layer.get_payload();
+		switch (layer.get_kind())
+		{
+		case ConsoleColor::kind::indexed:
+			out = put(out, background ? std::string_view("48;5;") : std::string_view("38;5;"));
+			return put(out, s_decimal[payload]);
+		case ConsoleColor::kind::rgb:
+			out = put(out, background ? std::string_view("48;2;") : std::string_view("38;2;"));
+			out = put(out, s_decimal[payload >> 16]);
+			*out++ = ';';
+			out = put(out, s_decimal[payload >> 8 & 0xFF]);
+			*out++ = ';';
+			return put(out, s_decimal[payload & 0xFF]);
+		default:
+			return put(out, s_basic_layers[(payload & 0xF) + (background ? 16 : 0)]);
+		}
+	}
+
+	/**
+	 @returns `layer`, or the nearest color the terminal can display
+	*/
+	ConsoleColor::value downgrade(const ConsoleColor::value layer,
+		const cons::TerminalInfo::color_depth depth) noexcept
+	{
+		using depth_type = cons::TerminalInfo::color_depth;
+		using cons::ColorQuantizer;
+		const auto layer_kind = layer.get_kind();
+		if (layer_kind == ConsoleColor::kind::basic || depth == depth_type::truecolor)
+			return layer;
+		if (depth == depth_type::indexed256)
+		{
+			static const auto& s_xterm256 = ColorQuantizer::get(ColorQuantizer::palette::xterm256);
+			return s_xterm256.quantize(layer);
+		}
+		return ConsoleColor::value(ConsoleColor::get_basic_color(layer));
+	}
+
+	/**
+	 The usual appearance of the basic colors, by 'color' value
+	*/
+	constexpr std::uint32_t s_basic_rgb[16] = {
+		0x000000, 0x000080, 0x008000, 0x008080,
+		0x800000, 0x800080, 0x808000, 0xC0C0C0,
+		0x808080, 0x0000FF, 0x00FF00, 0x00FFFF,
+		0xFF0000, 0xFF00FF, 0xFFFF00, 0xFFFFFF
+	};
+} // namespace
 
 namespace cons
 {
+#ifdef _WIN32
 	ConsoleColor::ConsoleColor()
 		: ConsoleColor(color::bright_white, color::black)
 	{
@@ -19,37 +174,126 @@ namespace cons
 		// [FIX?] Assumes csbi.wAttributes only contains a color value
 		*this = get_cons_console_color(csbi.wAttributes);
 	}
+#else
+	ConsoleColor::ConsoleColor()
+		: ConsoleColor(color::white, color::black)
+	{}
+#endif // _WIN32
 
-	ConsoleColor::ConsoleColor(const color foreground, 
-							   const color background) noexcept
+	ConsoleColor::ConsoleColor(const value foreground, 
+							   const value background) noexcept
 		: foreground_(foreground)
 		, background_(background)
 	{}
 
-	void ConsoleColor::set_foreground_color(const color foreground) noexcept
+	void ConsoleColor::set_foreground_color(const value foreground) noexcept
 	{
 		foreground_ = foreground;
 	}
 
-	void ConsoleColor::set_background_color(const color background) noexcept
+	void ConsoleColor::set_background_color(const value background) noexcept
 	{
 		background_ = background;
 	}
 
 	ConsoleColor::color ConsoleColor::get_foreground_color() const noexcept
 	{
-		return foreground_;
+		return get_basic_color(foreground_);
 	}
 
 	ConsoleColor::color ConsoleColor::get_background_color() const noexcept
 	{
-		return background_;
+		return get_basic_color(background_);
+	}
+
+	bool ConsoleColor::operator==(const ConsoleColor other) const noexcept
+	{
+		return foreground_ == other.foreground_ && background_ == other.background_;
+	}
+
+	bool ConsoleColor::operator!=(const ConsoleColor other) const noexcept
+	{
+		return !(*this == other);
+	}
+
+	ConsoleColor::ansi_sequence ConsoleColor::get_ansi_sequence(
+		const ConsoleColor cons_color) noexcept
+	{
+		ansi_sequence sequence;
+		auto fg = cons_color.foreground_;
+		auto bg = cons_color.background_;
+		if (fg.get_kind() != kind::basic || bg.get_kind() != kind::basic)
+		{
+			const auto depth = TerminalInfo::get().get_color_depth();
+			fg = downgrade(fg, depth);
+			bg = downgrade(bg, depth);
+		}
+
+		if (fg.get_kind() == kind::basic && bg.get_kind() == kind::basic)
+		{ // The common case is a single copy
+			const auto& pair = s_basic_pairs[fg.get_payload() | bg.get_payload() << 4];
+			std::memcpy(sequence.data_, pair.data, sizeof(pair.data));
+			sequence.size_ = pair.size;
+			return sequence;
+		}
+
+		auto out = put(sequence.data_, std::string_view("\x1b["));
+		out = put_layer(out, fg, false);
+		*out++ = ';';
+		out = put_layer(out, bg, true);
+		*out++ = 'm';
+		sequence.size_ = static_cast<unsigned char>(out - sequence.data_);
+		return sequence;
+	}
+
+	ConsoleColor::color ConsoleColor::get_basic_color(const value layer) noexcept
+	{
+		if (layer.get_kind() == kind::basic)
+			return static_cast<color>(layer.get_payload());
+
+		static const auto& s_quantizer =
+			ColorQuantizer::get(ColorQuantizer::palette::basic16);
+		return static_cast<color>(s_quantizer.quantize(get_rgb(layer)).get_payload());
+	}
+
+	std::uint32_t ConsoleColor::get_rgb(const value layer) noexcept
+	{
+		// The levels xterm uses for its color cube
+		static constexpr std::uint32_t s_levels[6] = { 0, 95, 135, 175, 215, 255 };
+
+		const auto payload = layer.get_payload();
+		switch (layer.get_kind())
+		{
+		case kind::basic:
+			return s_basic_rgb[payload & 0xF];
+		case kind::indexed:
+			if (payload < 16)
+			{ // ANSI order, so red and blue are swapped
+				const auto bits = get_ansi_color_number(static_cast<unsigned short>(payload & 0x7));
+				return s_basic_rgb[bits | (payload & 0x8)];
+			}
+			if (payload < 232)
+			{
+				const auto cube = payload - 16;
+				return s_levels[cube / 36] << 16 | s_levels[cube / 6 % 6] << 8 | s_levels[cube % 6];
+			}
+			return (8 + 10 * (payload - 232)) * 0x010101;
+		default:
+			return payload;
+		}
+	}
+
+	std::uint64_t ConsoleColor::get_attribute_id(const ConsoleColor cons_color) noexcept
+	{
+		return (static_cast<std::uint64_t>(cons_color.foreground_.get_bits()) << 32
+			| cons_color.background_.get_bits()) + 1;
 	}
 
+#ifdef _WIN32
 	WORD ConsoleColor::get_windows_console_color(const ConsoleColor cons_color)
 	{
-		const auto fg = static_cast<WORD>(cons_color.foreground_);
-		const auto bg = static_cast<WORD>(cons_color.background_);
+		const auto fg = static_cast<WORD>(cons_color.get_foreground_color());
+		const auto bg = static_cast<WORD>(cons_color.get_background_color());
 		return fg + static_cast<WORD>(16) * bg;
 	}
 
@@ -59,8 +303,9 @@ namespace cons
 		const WORD fg = windows_color % static_cast<WORD>(16);
 		return ConsoleColor(static_cast<color>(fg), static_cast<color>(bg));
 	}
+#endif // _WIN32
 
-	char const* SetConsoleTextAttributeFailureException::what() const
+	char const* SetConsoleTextAttributeFailureException::what() const noexcept
 	{
 		return "\nWINDOWS CONSOLE API FAILURE!\nFAILED CALL TO "
 			"SetConsoleTextAttribute(HANDLE, WORD)";
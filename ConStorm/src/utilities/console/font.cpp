@@ -47,6 +47,7 @@ namespace cons
 		return name;
 	}
 
+#ifdef _WIN32
 	ConsoleFont::ConsoleFont()
 		: family_(family::other)
 		, size_(size::other)
@@ -60,6 +61,11 @@ namespace cons
 
 		*this = get_cons_font(current_font);
 	}
+#else
+	ConsoleFont::ConsoleFont()
+		: ConsoleFont(nullptr)
+	{}
+#endif // _WIN32
 
 	ConsoleFont::ConsoleFont(const family font_family, 
 		const size font_size) noexcept
@@ -115,6 +121,7 @@ namespace cons
 		return size_;
 	}
 
+#ifdef _WIN32
 	CONSOLE_FONT_INFOEX ConsoleFont::get_windows_console_font(const ConsoleFont& font)
 	{
 		CONSOLE_FONT_INFOEX converted_font;
@@ -198,6 +205,7 @@ namespace cons
 
 		return converted_font;
 	}
+#endif // _WIN32
 
 	void ConsoleFont::copy(ConsoleFont& dest, const ConsoleFont& src)
 	{
@@ -211,7 +219,7 @@ namespace cons
 		dest.size_ = src.size_;
 	}
 
-	char const* CurrentWindowsConsoleFontFailureException::what() const
+	char const* CurrentWindowsConsoleFontFailureException::what() const noexcept
 	{
 		return "\nWINDOWS CONSOLE API FAILURE!\nFAILED CALL TO "
 			"[Get/Set]CurrentConsoleFontInfoEx(HANDLE, BOOL, "
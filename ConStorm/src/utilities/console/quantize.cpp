@@ -0,0 +1,150 @@
+/*
+ Code by Drake Johnson
+
+ Defines the ColorQuantizer class
+*/
+#include <cons/utilities/console/quantize.hpp>
+#include <algorithm>
+
+namespace
+{
+	using cons::ConsoleColor;
+
+	int distance(const std::uint32_t lhs, const std::uint32_t rhs) noexcept
+	{
+		const auto dr = static_cast<int>(lhs >> 16) - static_cast<int>(rhs >> 16);
+		const auto dg = static_cast<int>(lhs >> 8 & 0xFF) - static_cast<int>(rhs >> 8 & 0xFF);
+		const auto db = static_cast<int>(lhs & 0xFF) - static_cast<int>(rhs & 0xFF);
+		return dr * dr + dg * dg + db * db;
+	}
+
+	unsigned char nearest_basic(const std::uint32_t rgb) noexcept
+	{
+		unsigned char nearest = 0;
+		int nearest_distance = distance(rgb, ConsoleColor::get_rgb(ConsoleColor::color::black));
+		for (unsigned char i = 1; i < 16; ++i)
+		{
+			const auto d = distance(rgb, ConsoleColor::get_rgb(static_cast<ConsoleColor::color>(i)));
+			if (d < nearest_distance)
+			{
+				nearest = i;
+				nearest_distance = d;
+			}
+		}
+		return nearest;
+	}
+
+	/**
+	 Picks the nearest of two candidates: the color cube entry whose levels
+	 are each nearest to the channel, and the nearest gray. Entries 0 to 15
+	 vary too much between terminal themes to be chosen.
+	*/
+	unsigned char nearest_xterm(const std::uint32_t rgb) noexcept
+	{
+		const auto level = [](const unsigned channel) -> unsigned
+		{
+			if (channel < 48)
+				return 0;
+			if (channel < 115)
+				return 1;
+			return (channel - 35) / 40;
+		};
+		const auto r = rgb >> 16;
+		const auto g = rgb >> 8 & 0xFF;
+		const auto b = rgb & 0xFF;
+		const auto cube = static_cast<unsigned char>(16 + 36 * level(r) + 6 * level(g) + level(b));
+
+		const auto average = (r + g + b) / 3;
+		const auto gray = static_cast<unsigned char>(average > 238 ? 255 : 232 + (average < 3 ? 0 : (average - 3) / 10));
+
+		const auto cube_distance = distance(rgb, ConsoleColor::get_rgb(ConsoleColor::value::indexed(cube)));
+		const auto gray_distance = distance(rgb, ConsoleColor::get_rgb(ConsoleColor::value::indexed(gray)));
+		return gray_distance < cube_distance ? gray : cube;
+	}
+
+	constexpr int s_bayer[4][4] = {
+		{ 0, 8, 2, 10 },
+		{ 12, 4, 14, 6 },
+		{ 3, 11, 1, 9 },
+		{ 15, 7, 13, 5 }
+	};
+} // namespace
+
+namespace cons
+{
+	ColorQuantizer::ColorQuantizer(const palette target)
+		: target_(target)
+		, spread_(target == palette::basic16 ? 128 : 40)
+		, cube_()
+	{
+		constexpr unsigned mask = (1U << CUBE_BITS) - 1;
+		constexpr unsigned shift = 8 - CUBE_BITS;
+		constexpr unsigned half = 1U << (shift - 1);
+		for (size_t cell = 0; cell < CUBE_SIZE; ++cell)
+		{ // Map the center of each cell
+			const auto r = (static_cast<unsigned>(cell >> (2 * CUBE_BITS)) << shift) | half;
+			const auto g = ((static_cast<unsigned>(cell >> CUBE_BITS) & mask) << shift) | half;
+			const auto b = ((static_cast<unsigned>(cell) & mask) << shift) | half;
+			const auto rgb = static_cast<std::uint32_t>(r << 16 | g << 8 | b);
+			cube_[cell] = target == palette::basic16 ? nearest_basic(rgb) : nearest_xterm(rgb);
+		}
+	}
+
+	const ColorQuantizer& ColorQuantizer::get(const palette target)
+	{
+		if (target == palette::basic16)
+		{
+			static const ColorQuantizer s_basic16(palette::basic16);
+			return s_basic16;
+		}
+		static const ColorQuantizer s_xterm256(palette::xterm256);
+		return s_xterm256;
+	}
+
+	ConsoleColor::value ColorQuantizer::quantize(const ConsoleColor::value layer) const noexcept
+	{
+		return is_displayable(layer) ? layer : quantize(ConsoleColor::get_rgb(layer));
+	}
+
+	void ColorQuantizer::quantize_row(ConsoleColor::value* colors,
+		const size_t count) const noexcept
+	{
+		for (size_t i = 0; i < count; ++i)
+			colors[i] = quantize(colors[i]);
+	}
+
+	void ColorQuantizer::dither_row(ConsoleColor::value* colors,
+		const size_t count, const size_t row) const noexcept
+	{
+		// Offsets for each column of the matrix, centered on zero and
+		// spanning about one palette step
+		int offsets[4];
+		for (size_t x = 0; x < 4; ++x)
+			offsets[x] = (2 * s_bayer[row & 3][x] - 15) * spread_ / 32;
+
+		const auto offset_channel = [](const std::uint32_t channel, const int offset)
+		{
+			return static_cast<std::uint32_t>(
+				std::clamp(static_cast<int>(channel) + offset, 0, 255));
+		};
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (is_displayable(colors[i]))
+				continue;
+
+			const auto rgb = ConsoleColor::get_rgb(colors[i]);
+			const auto offset = offsets[i & 3];
+			colors[i] = quantize(offset_channel(rgb >> 16, offset) << 16
+				| offset_channel(rgb >> 8 & 0xFF, offset) << 8
+				| offset_channel(rgb & 0xFF, offset));
+		}
+	}
+
+	bool ColorQuantizer::is_displayable(const ConsoleColor::value layer) const noexcept
+	{
+		const auto layer_kind = layer.get_kind();
+		return layer_kind == ConsoleColor::kind::basic
+			|| (target_ == palette::xterm256 && layer_kind == ConsoleColor::kind::indexed);
+	}
+} // namespace cons
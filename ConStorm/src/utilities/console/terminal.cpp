@@ -0,0 +1,98 @@
+/*
+ Code by Drake Johnson
+
+ Defines the TerminalInfo class
+*/
+#include <cons/utilities/console/terminal.hpp>
+#include <cons/output/backend.hpp>
+#include <cstdlib>
+#include <string_view>
+
+namespace
+{
+	std::atomic<cons::TerminalInfo*> s_instance{ nullptr };
+
+	/**
+	 Marks the size stale. Called by the backend on every resize, possibly
+	 from a signal handler.
+	*/
+	void invalidate_size() noexcept
+	{
+		if (auto* info = s_instance.load(std::memory_order_relaxed))
+			info->invalidate();
+	}
+
+	cons::TerminalInfo::color_depth detect_color_depth()
+	{
+		using depth = cons::TerminalInfo::color_depth;
+		if constexpr (!cons::console_backend::HOST_TERMINAL)
+			return depth::truecolor;
+		if constexpr (!cons::console_backend::INLINE_STYLES)
+			return depth::basic; // Colors go through the console API
+
+		if (const char* colorterm = std::getenv("COLORTERM"))
+		{
+			const std::string_view value(colorterm);
+			if (value == "truecolor" || value == "24bit")
+				return depth::truecolor;
+		}
+
+		const auto max_colors = cons::Terminfo::get().get_number(
+			cons::Terminfo::number::max_colors);
+		if (max_colors >= 256)
+			return depth::indexed256;
+		if (max_colors >= 8)
+			return depth::basic;
+
+		// Without a terminfo entry, assume the colors every ANSI terminal has
+		return cons::Terminfo::get().is_loaded() ? depth::none : depth::basic;
+	}
+} // namespace
+
+namespace cons
+{
+	TerminalInfo::TerminalInfo()
+	{
+		stdout_tty_ = console_backend::is_output_terminal();
+		stdin_tty_ = console_backend::is_input_terminal();
+
+		if constexpr (console_backend::HOST_TERMINAL)
+		{
+			const char* term = std::getenv("TERM");
+			const bool dumb = term && std::string_view(term) == "dumb";
+			const bool no_color = std::getenv("NO_COLOR") != nullptr;
+			styled_.store(stdout_tty_ && !dumb && !no_color, std::memory_order_relaxed);
+		}
+		else
+			styled_.store(true, std::memory_order_relaxed);
+		depth_ = detect_color_depth();
+		query_size();
+	}
+
+	TerminalInfo& TerminalInfo::get()
+	{
+		static TerminalInfo s_info;
+		// Registered once the instance exists, since the callback uses it
+		static const bool s_registered = []
+		{
+			s_instance.store(&s_info, std::memory_order_relaxed);
+			console_backend::on_resize(invalidate_size);
+			return true;
+		}();
+		static_cast<void>(s_registered);
+		return s_info;
+	}
+
+	void TerminalInfo::query_size() noexcept
+	{
+		stale_.store(false, std::memory_order_relaxed);
+
+		backend::terminal_size size{ DEFAULT_COLUMNS, DEFAULT_ROWS };
+		if (stdout_tty_ && !console_backend::query_size(size))
+			size = { DEFAULT_COLUMNS, DEFAULT_ROWS };
+
+		columns_.store(size.columns, std::memory_order_relaxed);
+		rows_.store(size.rows, std::memory_order_relaxed);
+		generation_.fetch_add(1, std::memory_order_relaxed);
+	}
+} // namespace cons
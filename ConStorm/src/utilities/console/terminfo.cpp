@@ -0,0 +1,411 @@
+/*
+ Code by Drake Johnson
+
+ Defines the Terminfo class
+*/
+#include <cons/utilities/console/terminfo.hpp>
+#include <cons/output/buffer.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+	namespace fs = std::filesystem;
+
+	constexpr int LEGACY_MAGIC = 0432;
+	constexpr int EXTENDED_NUMBERS_MAGIC = 01036;
+	constexpr size_t HEADER_SIZE = 12;
+
+	/**
+	 The terminfo format stores every integer in little-endian order
+	*/
+	int read_short(const std::string& data, const size_t pos)
+	{
+		const auto lo = static_cast<unsigned char>(data[pos]);
+		const auto hi = static_cast<unsigned char>(data[pos + 1]);
+		return static_cast<short>(lo | hi << 8);
+	}
+
+	int read_int(const std::string& data, const size_t pos)
+	{
+		unsigned value = 0;
+		for (size_t i = 4; i-- > 0;)
+			value = value << 8 | static_cast<unsigned char>(data[pos + i]);
+		return static_cast<int>(value);
+	}
+
+	std::string remove_padding(const std::string_view cap)
+	{
+		std::string result;
+		result.reserve(cap.size());
+		for (size_t i = 0; i < cap.size(); ++i)
+		{
+			if (cap[i] == '$' && i + 1 < cap.size() && cap[i + 1] == '<')
+			{
+				const auto end = cap.find('>', i);
+				if (end != std::string_view::npos)
+				{
+					i = end;
+					continue;
+				}
+			}
+			result.push_back(cap[i]);
+		}
+		return result;
+	}
+
+	/**
+	 Skips a conditional branch which is not taken
+
+	 @param cap  The capability being expanded
+	 @param pos  The position after the '%t' or '%e' which starts the branch
+	 @param stop_at_else Whether an '%e' at the same nesting level ends the
+	                     branch (true after '%t'), or only '%;' does
+	 @returns The position after the '%e' or '%;' which ended the branch
+	*/
+	size_t skip_branch(const std::string_view cap, size_t pos, const bool stop_at_else)
+	{
+		unsigned depth = 0;
+		while (pos + 1 < cap.size())
+		{
+			if (cap[pos] != '%')
+			{
+				++pos;
+				continue;
+			}
+
+			const char op = cap[pos + 1];
+			pos += 2;
+			if (op == '?')
+				++depth;
+			else if (op == ';')
+			{
+				if (depth == 0)
+					return pos;
+				--depth;
+			}
+			else if (op == 'e' && depth == 0 && stop_at_else)
+				return pos;
+		}
+		return cap.size();
+	}
+
+	/**
+	 @returns The directories which may hold terminfo entries, in the order
+	          curses searches them
+	*/
+	std::vector<fs::path> get_search_dirs()
+	{
+		std::vector<fs::path> dirs;
+		if (const char* terminfo = std::getenv("TERMINFO"))
+			dirs.emplace_back(terminfo);
+		if (const char* home = std::getenv("HOME"))
+			dirs.emplace_back(fs::path(home) / ".terminfo");
+
+		const auto add_defaults = [&dirs]
+		{
+			for (const char* dir : { "/etc/terminfo", "/lib/terminfo",
+				"/usr/share/terminfo", "/usr/lib/terminfo" })
+				dirs.emplace_back(dir);
+		};
+
+		if (const char* terminfo_dirs = std::getenv("TERMINFO_DIRS"))
+		{ // An empty element stands for the default directories
+			const std::string_view list(terminfo_dirs);
+			size_t begin = 0;
+			while (begin <= list.size())
+			{
+				auto end = list.find(':', begin);
+				if (end == std::string_view::npos)
+					end = list.size();
+				if (end == begin)
+					add_defaults();
+				else
+					dirs.emplace_back(std::string(list.substr(begin, end - begin)));
+				begin = end + 1;
+			}
+		}
+		else
+			add_defaults();
+		return dirs;
+	}
+
+	/**
+	 The static variables of 'Terminfo::expand()' (%P and %g with A to Z),
+	 kept between calls, per thread
+	*/
+	thread_local int t_static_vars[26] = {};
+
+	void put(std::string& out, const char ch) { out.push_back(ch); }
+	void put(cons::OutputBuffer& out, const char ch) { out.append(ch); }
+
+	/**
+	 Expands `cap` onto the end of `result`, which is a std::string or an
+	 OutputBuffer
+	*/
+	template <class OutTy>
+	void expand_into(OutTy& result, const std::string_view cap,
+		const std::initializer_list<int> params)
+	{
+		int param[9] = {};
+		size_t count = 0;
+		for (const auto value : params)
+		{
+			if (count < 9)
+				param[count++] = value;
+		}
+
+		int stack[32] = {};
+		size_t depth = 0;
+		const auto push = [&](const int value) { if (depth < 32) stack[depth++] = value; };
+		const auto pop = [&] { return depth > 0 ? stack[--depth] : 0; };
+		int dynamic_vars[26] = {};
+
+		for (size_t i = 0; i < cap.size(); ++i)
+		{
+			if (cap[i] != '%' || i + 1 == cap.size())
+			{
+				put(result, cap[i]);
+				continue;
+			}
+
+			char op = cap[++i];
+			switch (op)
+			{
+			case '%': put(result, '%'); break;
+			case 'c': put(result, static_cast<char>(pop())); break;
+			case 'p':
+				if (i + 1 < cap.size() && cap[i + 1] >= '1' && cap[i + 1] <= '9')
+					push(param[cap[++i] - '1']);
+				break;
+			case 'P':
+			case 'g':
+				if (i + 1 < cap.size())
+				{
+					const char name = cap[++i];
+					int* var = name >= 'a' && name <= 'z' ? &dynamic_vars[name - 'a']
+						: name >= 'A' && name <= 'Z' ? &t_static_vars[name - 'A'] : nullptr;
+					if (var == nullptr)
+						break;
+					if (op == 'P')
+						*var = pop();
+					else
+						push(*var);
+				}
+				break;
+			case '\'':
+				if (i + 1 < cap.size())
+					push(static_cast<unsigned char>(cap[++i]));
+				if (i + 1 < cap.size() && cap[i + 1] == '\'')
+					++i;
+				break;
+			case '{':
+			{
+				int value = 0;
+				while (++i < cap.size() && cap[i] != '}')
+					value = value * 10 + (cap[i] - '0');
+				push(value);
+				break;
+			}
+			case 'l': pop(); push(0); break; // String parameters are not supported
+			case 'i': ++param[0]; ++param[1]; break;
+			case '!': push(!pop()); break;
+			case '~': push(~pop()); break;
+			case '+': case '-': case '*': case '/': case 'm':
+			case '&': case '|': case '^': case '=': case '>': case '<': case 'A': case 'O':
+			{
+				const int b = pop();
+				const int a = pop();
+				switch (op)
+				{
+				case '+': push(a + b); break;
+				case '-': push(a - b); break;
+				case '*': push(a * b); break;
+				case '/': push(b != 0 ? a / b : 0); break;
+				case 'm': push(b != 0 ? a % b : 0); break;
+				case '&': push(a & b); break;
+				case '|': push(a | b); break;
+				case '^': push(a ^ b); break;
+				case '=': push(a == b); break;
+				case '>': push(a > b); break;
+				case '<': push(a < b); break;
+				case 'A': push(a && b); break;
+				default: push(a || b); break;
+				}
+				break;
+			}
+			case '?':
+			case ';':
+				break;
+			case 't':
+				if (!pop())
+					i = skip_branch(cap, i + 1, true) - 1;
+				break;
+			case 'e':
+				i = skip_branch(cap, i + 1, false) - 1;
+				break;
+			default:
+			{ // %[[:]flags][width[.precision]][doxXs]
+				const auto begin = i;
+				if (op == ':')
+					++i;
+				while (i < cap.size() && std::string_view("-+# 0123456789.").find(cap[i]) != std::string_view::npos)
+					++i;
+				if (i == cap.size() || std::string_view("doxXs").find(cap[i]) == std::string_view::npos)
+				{
+					put(result, '%');
+					i = begin - 1;
+					break;
+				}
+
+				std::string spec("%");
+				for (auto j = begin; j < i; ++j)
+				{
+					if (cap[j] != ':')
+						spec.push_back(cap[j]);
+				}
+				spec.push_back(cap[i] == 's' ? 'd' : cap[i]);
+
+				char digits[32];
+				const int size = std::snprintf(digits, sizeof(digits), spec.c_str(), pop());
+				if (size > 0)
+					result.append(digits, static_cast<size_t>(size) < sizeof(digits) ? size : sizeof(digits) - 1);
+				break;
+			}
+			}
+		}
+	}
+} // namespace
+
+namespace cons
+{
+	Terminfo Terminfo::load(const std::string_view term)
+	{
+		Terminfo entry;
+		if (term.empty() || term.find('/') != std::string_view::npos)
+			return entry;
+
+		static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+		const auto first = static_cast<unsigned char>(term.front());
+		const std::string letter_dir(1, term.front());
+		const std::string hex_dir{ HEX_DIGITS[first >> 4], HEX_DIGITS[first & 0xF] };
+
+		for (const auto& dir : get_search_dirs())
+		{ // Entries are filed by their first letter, or its hex code on macOS
+			for (const auto& sub_dir : { letter_dir, hex_dir })
+			{
+				std::ifstream file(dir / sub_dir / std::string(term), std::ios::binary);
+				if (!file)
+					continue;
+
+				const std::string data{ std::istreambuf_iterator<char>(file),
+					std::istreambuf_iterator<char>() };
+				if (entry.parse(data))
+					return entry;
+				entry = Terminfo();
+			}
+		}
+		return entry;
+	}
+
+	const Terminfo& Terminfo::get()
+	{
+		static const Terminfo s_entry = []
+		{
+#ifdef CONS_BACKEND_MEMORY
+			// The simulated terminal has only the built-in ANSI capabilities
+			return Terminfo();
+#else
+			const char* term = std::getenv("TERM");
+			return load(term ? term : "");
+#endif // CONS_BACKEND_MEMORY
+		}();
+		return s_entry;
+	}
+
+	int Terminfo::get_number(const number cap) const noexcept
+	{
+		const auto index = static_cast<size_t>(cap);
+		return index < numbers_.size() ? numbers_[index] : -1;
+	}
+
+	std::string_view Terminfo::get_string(const string cap) const noexcept
+	{
+		const auto index = static_cast<size_t>(cap);
+		return index < strings_.size() ? std::string_view(strings_[index]) : std::string_view();
+	}
+
+	std::string Terminfo::expand(const std::string_view cap, const std::initializer_list<int> params)
+	{
+		std::string result;
+		result.reserve(cap.size() + 8);
+		expand_into(result, cap, params);
+		return result;
+	}
+
+	void Terminfo::expand(OutputBuffer& buf, const std::string_view cap,
+		const std::initializer_list<int> params)
+	{
+		expand_into(buf, cap, params);
+	}
+
+	bool Terminfo::parse(const std::string& data)
+	{
+		if (data.size() < HEADER_SIZE)
+			return false;
+
+		const auto magic = read_short(data, 0);
+		if (magic != LEGACY_MAGIC && magic != EXTENDED_NUMBERS_MAGIC)
+			return false;
+
+		const auto name_size = read_short(data, 2);
+		const auto flag_count = read_short(data, 4);
+		const auto number_count = read_short(data, 6);
+		const auto string_count = read_short(data, 8);
+		const auto table_size = read_short(data, 10);
+		if (name_size <= 0 || flag_count < 0 || number_count < 0
+			|| string_count < 0 || table_size < 0)
+			return false;
+
+		const size_t number_size = magic == LEGACY_MAGIC ? 2 : 4;
+		size_t pos = HEADER_SIZE + name_size + flag_count;
+		pos += pos % 2; // Numbers start on an even byte
+		const size_t numbers_pos = pos;
+		const size_t offsets_pos = numbers_pos + number_count * number_size;
+		const size_t table_pos = offsets_pos + string_count * size_t{ 2 };
+		if (table_pos + table_size > data.size())
+			return false;
+
+		// The names are separated by '|' and terminated by NUL
+		name_.assign(data, HEADER_SIZE, name_size - 1);
+		if (name_.empty())
+			return false;
+
+		numbers_.resize(number_count);
+		for (int i = 0; i < number_count; ++i)
+		{
+			const auto value = number_size == 2
+				? read_short(data, numbers_pos + i * number_size)
+				: read_int(data, numbers_pos + i * number_size);
+			numbers_[i] = value < 0 ? -1 : value;
+		}
+
+		strings_.resize(string_count);
+		for (int i = 0; i < string_count; ++i)
+		{
+			const auto offset = read_short(data, offsets_pos + i * size_t{ 2 });
+			if (offset < 0 || offset >= table_size)
+				continue; // Absent or cancelled
+
+			const std::string_view table(data.data() + table_pos, table_size);
+			const auto end = table.find('\0', offset);
+			if (end == std::string_view::npos)
+				continue;
+			strings_[i] = remove_padding(table.substr(offset, end - offset));
+		}
+		return true;
+	}
+} // namespace cons
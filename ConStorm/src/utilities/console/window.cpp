@@ -4,6 +4,8 @@
  Defines the ConsoleWindow class
 */
 #include <cons/utilities/console/window.hpp>
+#include <cons/utilities/console/terminal.hpp>
+#include <cons/output/backend.hpp>
 
 namespace cons
 {
@@ -14,39 +16,36 @@ namespace cons
 
 	void ConsoleWindow::apply_to_console() const
 	{
-		const auto hout = GetStdHandle(STD_OUTPUT_HANDLE);
+		{
+			OutputFrame frame;
+			console_backend::set_default_style(out(), color_);
+		}
 
-		// Set colors
-		const auto win_color = ConsoleColor::get_windows_console_color(color_);
-		if (!SetConsoleTextAttribute(hout, win_color))
-			throw SetConsoleTextAttributeFailureException();
+#ifdef _WIN32
+		if (!TerminalInfo::get().is_styled())
+			return;
 
-		// Set font
 		auto win_font = ConsoleFont::get_windows_console_font(font_);
-		if (!SetCurrentConsoleFontEx(hout, false, &win_font))
+		if (!SetCurrentConsoleFontEx(GetStdHandle(STD_OUTPUT_HANDLE), false, &win_font))
 			throw CurrentWindowsConsoleFontFailureException();
+#endif // _WIN32
 	}
 
 	void ConsoleWindow::reset_color() const
 	{
-		const auto hout = GetStdHandle(STD_OUTPUT_HANDLE);
-
-		// Set to original colors
-		const auto win_color = ConsoleColor::get_windows_console_color(
-			original_color_);
-		if (!SetConsoleTextAttribute(hout, win_color))
-			throw SetConsoleTextAttributeFailureException();
+		OutputFrame frame;
+		console_backend::restore_default_style(out());
 	}
 
 	void ConsoleWindow::reset_font() const
 	{
-		const auto hout = GetStdHandle(STD_OUTPUT_HANDLE);
-
+#ifdef _WIN32
 		// Set to original font
 		auto win_font = ConsoleFont::get_windows_console_font(
 			original_font_);
-		if (!SetCurrentConsoleFontEx(hout, false, &win_font))
+		if (!SetCurrentConsoleFontEx(GetStdHandle(STD_OUTPUT_HANDLE), false, &win_font))
 			throw CurrentWindowsConsoleFontFailureException();
+#endif // _WIN32
 	}
 
 	void ConsoleWindow::set_color(const ConsoleColor color)
@@ -54,12 +53,12 @@ namespace cons
 		color_ = color;
 	}
 
-	void ConsoleWindow::set_foreground_color(ConsoleColor::color fg_color)
+	void ConsoleWindow::set_foreground_color(ConsoleColor::value fg_color)
 	{
 		color_.set_foreground_color(fg_color);
 	}
 
-	void ConsoleWindow::set_background_color(ConsoleColor::color bg_color)
+	void ConsoleWindow::set_background_color(ConsoleColor::value bg_color)
 	{
 		color_.set_background_color(bg_color);
 	}
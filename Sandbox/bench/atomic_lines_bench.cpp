@@ -0,0 +1,93 @@
+/*
+ Code by Drake Johnson
+
+ Measures the cost of printing from several threads at once with
+ cons::set_atomic_lines(true), which locks only around the write of each
+ formatted print() into the sink, against holding a lock around the whole
+ print() call, formatting included.
+
+ 1, 4, 16, and 64 threads share 1.6 million print() calls of 5 mixed
+ arguments each, written into a NullSink. Reports the aggregate wall time
+ per print(). On a single core this shows the cost of the lock and of
+ context switching; only on several cores does it show how each scales.
+
+ Build (from the repository root):
+   g++ -O2 -std=c++17 -pthread -IConStorm/include Sandbox/bench/atomic_lines_bench.cpp \
+     $(find ConStorm/src -name '*.cpp' ! -path '*files*') -o atomic_lines_bench
+*/
+#include <cons/output.hpp>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr int PRINTS = 1'600'000;
+
+	/**
+	 @returns The wall time per print() of `threads` threads sharing
+	          PRINTS calls, each call made through `print_one`
+	*/
+	template <class FuncTy>
+	double time_per_print(const int threads, FuncTy&& print_one)
+	{
+		std::vector<std::thread> workers;
+		workers.reserve(threads);
+
+		const auto start = std::chrono::steady_clock::now();
+		for (int t = 0; t < threads; ++t)
+		{
+			workers.emplace_back([&, t]
+			{
+				const std::string name = "worker " + std::to_string(t);
+				for (int i = 0; i < PRINTS / threads; ++i)
+					print_one(name, i);
+			});
+		}
+		for (auto& worker : workers)
+			worker.join();
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::nano>(elapsed).count() / PRINTS;
+	}
+} // namespace
+
+int main()
+{
+	cons::NullSink sink;
+	cons::set_output_sink(&sink);
+
+	const int thread_counts[] = { 1, 4, 16, 64 };
+	double atomic[4] = {};
+	double locked[4] = {};
+	for (size_t i = 0; i < 4; ++i)
+	{
+		cons::set_atomic_lines(true);
+		atomic[i] = time_per_print(thread_counts[i], [](const std::string& name, const int n)
+		{
+			cons::print(name, n, n * 0.5, 'x', "line");
+		});
+		cons::set_atomic_lines(false);
+
+		std::mutex lock;
+		locked[i] = time_per_print(thread_counts[i], [&](const std::string& name, const int n)
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			cons::print(name, n, n * 0.5, 'x', "line");
+		});
+	}
+	cons::set_output_sink(nullptr);
+
+	std::printf("%-24s", "threads");
+	for (const int threads : thread_counts)
+		std::printf(" %8d", threads);
+	std::printf("\n%-24s", "atomic lines (ns/print)");
+	for (const double ns : atomic)
+		std::printf(" %8.1f", ns);
+	std::printf("\n%-24s", "lock around print()");
+	for (const double ns : locked)
+		std::printf(" %8.1f", ns);
+	std::printf("\n\n%zu writes\n", sink.get_writes());
+}
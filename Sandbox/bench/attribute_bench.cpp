@@ -0,0 +1,85 @@
+/*
+ Code by Drake Johnson
+
+ Counts the console attribute transitions (color changes) the library
+ makes for 500 textf objects, using 'cons::get_attribute_transitions()':
+
+   - all in one color, back to back in one frame
+   - alternating between two colors, back to back in one frame
+   - all in one color, one per line, as cons::print() writes them
+   - all in one color, each in its own frame, which costs one change to
+     the color and one back for every object (what every textf cost
+     before the buffer tracked attributes)
+
+ Output is captured in a MemorySink, with styling forced on.
+
+ Build (from the repository root):
+   g++ -O2 -std=c++17 -pthread -IConStorm/include Sandbox/bench/attribute_bench.cpp \
+     $(find ConStorm/src -name '*.cpp' ! -path '*files*') -o attribute_bench
+*/
+#include <cons/output.hpp>
+#include <cstdio>
+
+namespace
+{
+	constexpr int OBJECTS = 500;
+
+	/**
+	 Prints the attribute transitions and bytes that `func` causes
+	*/
+	template <class FuncTy>
+	void report(const char* name, cons::MemorySink& sink, FuncTy&& func)
+	{
+		sink.clear();
+		const auto before = cons::get_attribute_transitions();
+		func();
+		std::printf("%-30s %12zu %10zu\n", name,
+			cons::get_attribute_transitions() - before, sink.size());
+	}
+} // namespace
+
+int main()
+{
+	cons::MemorySink sink;
+	cons::set_output_sink(&sink);
+	cons::TerminalInfo::get().set_styled(true);
+
+	cons::textf red("Red text ");
+	red.set_foreground_color(cons::ConsoleColor::color::red);
+	cons::textf blue("Blue text ");
+	blue.set_foreground_color(cons::ConsoleColor::color::blue);
+
+	std::printf("%d textf objects\n", OBJECTS);
+	std::printf("%-30s %12s %10s\n", "case", "transitions", "bytes");
+	report("same color, one frame", sink, [&]
+	{
+		cons::OutputFrame frame;
+		for (int i = 0; i < OBJECTS; ++i)
+			cons::format_to(cons::out(), red);
+	});
+	report("two colors, one frame", sink, [&]
+	{
+		cons::OutputFrame frame;
+		for (int i = 0; i < OBJECTS; ++i)
+			cons::format_to(cons::out(), (i & 1) ? blue : red);
+	});
+	report("same color, one per line", sink, [&]
+	{
+		cons::OutputFrame frame;
+		for (int i = 0; i < OBJECTS; ++i)
+		{ // What print() does for each of its arguments
+			cons::format_to(cons::out(), red);
+			cons::out().append('\n');
+		}
+	});
+	report("same color, one per frame", sink, [&]
+	{
+		for (int i = 0; i < OBJECTS; ++i)
+		{
+			cons::OutputFrame frame;
+			cons::format_to(cons::out(), red);
+		}
+	});
+
+	cons::set_output_sink(nullptr);
+}
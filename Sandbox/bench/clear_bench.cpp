@@ -0,0 +1,70 @@
+/*
+ Code by Drake Johnson
+
+ Measures redraws per second of a 5-line menu that clears the screen
+ first, with cls() (the sequence read once from $TERM's terminfo entry
+ and cached) against running 'tput clear' for every clear, which is how
+ the screen used to be cleared outside Windows.
+
+ The menu is captured in a MemorySink, with styling forced on; tput's
+ output goes to /dev/null. The cached sequence depends on $TERM's entry
+ (try TERM=xterm-256color, or an unknown name for the ANSI fallback).
+
+ Build (from the repository root):
+   g++ -O2 -std=c++17 -pthread -IConStorm/include Sandbox/bench/clear_bench.cpp \
+     $(find ConStorm/src -name '*.cpp' ! -path '*files*') -o clear_bench
+*/
+#include <cons/output.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+	void draw_menu()
+	{
+		cons::print("Main Menu", " (1) Start", " (2) Settings", " (3) Exit", "Choice: ");
+	}
+
+	/**
+	 @returns The redraws per second of `redraws` calls to `func`
+	*/
+	template <class FuncTy>
+	double redraws_per_second(cons::MemorySink& sink, const int redraws, FuncTy&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < redraws; ++i)
+		{
+			sink.clear();
+			func();
+		}
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		return redraws / std::chrono::duration<double>(elapsed).count();
+	}
+} // namespace
+
+int main()
+{
+	cons::MemorySink sink;
+	cons::set_output_sink(&sink);
+	cons::TerminalInfo::get().set_styled(true);
+
+	const double tput = redraws_per_second(sink, 200, []
+	{
+		if (std::system("tput clear > /dev/null 2>&1") != 0)
+			std::exit(1);
+		draw_menu();
+	});
+	const double cached = redraws_per_second(sink, 2'000'000, []
+	{
+		cons::OutputFrame frame; // cls() and the menu are one write
+		cons::cls();
+		draw_menu();
+	});
+	cons::set_output_sink(nullptr);
+
+	const char* const term = std::getenv("TERM");
+	std::printf("TERM=%s\n\n", term != nullptr ? term : "");
+	std::printf("tput clear:       %14.0f redraws/s\n", tput);
+	std::printf("cached sequence:  %14.0f redraws/s\n", cached);
+}
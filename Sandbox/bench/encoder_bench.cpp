@@ -0,0 +1,119 @@
+/*
+ Code by Drake Johnson
+
+ Measures the bytes per frame the UpdateEncoder writes for menu redraws,
+ against a full repaint of the same frame, for an unchanged menu, one
+ changed option, a longer prompt, a switch to a different menu, and the
+ switch back. The encoder is measured without and with repeat_char.
+
+ The encoder prices moves by the capabilities of $TERM's terminfo entry,
+ so the results depend on it (try TERM=xterm-256color, TERM=screen, or an
+ unknown name for the built-in ANSI capabilities). Output is captured in
+ a MemorySink, with styling forced on.
+
+ Build (from the repository root):
+   g++ -O2 -std=c++17 -pthread -IConStorm/include Sandbox/bench/encoder_bench.cpp \
+     $(find ConStorm/src -name '*.cpp' ! -path '*files*') -o encoder_bench
+*/
+#include <cons/output.hpp>
+#include <cons/menus.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+	/**
+	 Exposes the menu's redraw without waiting for input
+	*/
+	class bench_menu final : public cons::Menu
+	{
+	public:
+		using Menu::Menu;
+
+		void redraw() const { display(); }
+	};
+
+	/**
+	 @returns The bytes one redraw of `menu` writes, after a full repaint
+	          when `repaint` is set
+	*/
+	size_t redraw(cons::MemorySink& sink, const bench_menu& menu, const bool repaint)
+	{
+		if (repaint)
+			cons::Screen::get().invalidate();
+
+		sink.clear();
+		menu.redraw();
+		return sink.size();
+	}
+} // namespace
+
+int main()
+{
+	cons::MemorySink sink;
+	cons::set_output_sink(&sink);
+	cons::TerminalInfo::get().set_styled(true);
+
+	bench_menu main_menu(cons::Header("Main Menu"));
+	main_menu.set_description("This is the main menu. Below, select the number "
+		"that corresponds with your preferred option.", 60);
+	for (int i = 0; i < 8; ++i)
+		main_menu.append_option("Option number " + std::to_string(i + 1), nullptr);
+	main_menu.set_prompt_msg("Choice: ");
+
+	bench_menu other_menu(cons::Header("Settings"));
+	other_menu.set_description("A different menu with different text in every "
+		"row, so that nearly every cell changes.", 60);
+	for (int i = 0; i < 8; ++i)
+		other_menu.append_option("Setting " + std::string(i + 3, '*'), nullptr);
+
+	const char* const term = std::getenv("TERM");
+	std::printf("TERM=%s\n\n", term != nullptr ? term : "");
+	std::printf("%-12s %10s %10s %10s %10s %10s\n", "encoding", "unchanged", "one-line",
+		"prompt", "switch", "back");
+
+	const struct
+	{
+		const char* name;
+		bool repaint;
+		bool repeat;
+	} runs[] = {
+		{ "repaint", true, false },
+		{ "encoded", false, false },
+		{ "encoded+rep", false, true }
+	};
+	for (const auto& run : runs)
+	{
+		cons::UpdateEncoder::set_repeat_enabled(run.repeat);
+		main_menu[3].text = "Option number 4";
+		redraw(sink, main_menu, true);
+
+		const auto unchanged = redraw(sink, main_menu, run.repaint);
+		main_menu[3].text = "Option number 4 (selected)";
+		const auto one_line = redraw(sink, main_menu, run.repaint);
+		main_menu.set_prompt_msg("Choice (1-8): ");
+		const auto prompt = redraw(sink, main_menu, run.repaint);
+		main_menu.set_prompt_msg("Choice: ");
+		const auto switched = redraw(sink, other_menu, run.repaint);
+		const auto back = redraw(sink, main_menu, run.repaint);
+
+		std::printf("%-12s %10zu %10zu %10zu %10zu %10zu\n", run.name,
+			unchanged, one_line, prompt, switched, back);
+	}
+	cons::UpdateEncoder::set_repeat_enabled(false);
+
+	constexpr int REDRAWS = 20000;
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < REDRAWS; ++i)
+	{
+		main_menu[3].text = (i & 1) ? "Option number 4" : "Option number 4 (selected)";
+		redraw(sink, main_menu, false);
+	}
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	std::printf("\none-line redraw: %.2f us\n",
+		std::chrono::duration<double, std::micro>(elapsed).count() / REDRAWS);
+
+	cons::set_output_sink(nullptr);
+}
@@ -0,0 +1,122 @@
+/*
+ Code by Drake Johnson
+
+ Measures the writes and wall time of one menu step under each
+ FlushPolicy. A step is what a menu loop does between two inputs: a status
+ print(), cls(), the menu's redraw, and the flush the library makes before
+ it blocks on std::cin ('flush_before_input()').
+
+ Output goes to /dev/null through an FdSink, wrapped to count the calls to
+ 'write()' that reach it. Against a real terminal each write is a round
+ trip, so the difference per step grows with the terminal's latency.
+ Styling is forced on, so cls() and the menu write what they would write
+ to a terminal.
+
+ Build (from the repository root):
+   g++ -O2 -std=c++17 -pthread -IConStorm/include Sandbox/bench/flush_policy_bench.cpp \
+     $(find ConStorm/src -name '*.cpp' ! -path '*files*') -o flush_policy_bench
+*/
+#include <cons/output.hpp>
+#include <cons/menus.hpp>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+	/**
+	 Exposes the menu's redraw without waiting for input
+	*/
+	class bench_menu final : public cons::Menu
+	{
+	public:
+		using Menu::Menu;
+
+		void redraw() const { display(); }
+	};
+
+	/**
+	 Forwards to another sink, counting the calls to 'write()'
+	*/
+	class counting_sink final : public cons::OutputSink
+	{
+	public:
+		explicit counting_sink(cons::OutputSink& target) noexcept : target_(target) {}
+
+		void write(const char* data, const size_t size) override
+		{
+			++writes_;
+			target_.write(data, size);
+		}
+
+		[[nodiscard]] size_t get_writes() const noexcept { return writes_; }
+		void reset() noexcept { writes_ = 0; }
+
+	private:
+		cons::OutputSink& target_;
+		size_t writes_ = 0;
+	};
+
+	void step(const bench_menu& menu, const int i)
+	{
+		cons::print("Last choice: " + std::to_string(i % 4 + 1));
+		cons::cls();
+		menu.redraw();
+		cons::flush_before_input();
+	}
+} // namespace
+
+int main()
+{
+	const int null_fd = ::open("/dev/null", O_WRONLY);
+	if (null_fd < 0)
+	{
+		std::perror("/dev/null");
+		return 1;
+	}
+	cons::FdSink null_sink(null_fd);
+	counting_sink sink(null_sink);
+	cons::set_output_sink(&sink);
+	cons::TerminalInfo::get().set_styled(true);
+
+	bench_menu menu(cons::Header("Main Menu"));
+	menu.set_description("This is the main menu. Below, select the number "
+		"that corresponds with your preferred option.", 40);
+	for (int i = 0; i < 4; ++i)
+		menu.append_option("Option number " + std::to_string(i + 1), nullptr);
+	menu.set_prompt_msg("Choice: ");
+
+	const struct
+	{
+		const char* name;
+		cons::FlushPolicy policy;
+	} runs[] = {
+		{ "immediate", cons::FlushPolicy::immediate },
+		{ "on_frame", cons::FlushPolicy::on_frame },
+		{ "on_input", cons::FlushPolicy::on_input }
+	};
+
+	constexpr int STEPS = 200'000;
+	std::fprintf(stderr, "%-12s %12s %10s\n", "policy", "writes/step", "ns/step");
+	for (const auto& run : runs)
+	{
+		cons::set_flush_policy(run.policy);
+		step(menu, 0);
+		sink.reset();
+
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < STEPS; ++i)
+			step(menu, i);
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+
+		std::fprintf(stderr, "%-12s %12.2f %10.1f\n", run.name,
+			static_cast<double>(sink.get_writes()) / STEPS,
+			std::chrono::duration<double, std::nano>(elapsed).count() / STEPS);
+	}
+
+	cons::set_flush_policy(cons::FlushPolicy::on_frame);
+	cons::set_output_sink(nullptr);
+	::close(null_fd);
+}
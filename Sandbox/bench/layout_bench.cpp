@@ -0,0 +1,101 @@
+/*
+ Code by Drake Johnson
+
+ Measures how much of a Layout is recomputed when one widget changes,
+ against laying out the whole tree again. The tree is a dashboard: a
+ header over two bordered columns of 40 wrapped text widgets each.
+
+ Reports the measure and arrange passes of a one-widget relayout, then
+ the time of a one-widget relayout, a full layout of a fresh tree, and an
+ update with nothing changed. Nothing is written to the terminal.
+
+ Build (from the repository root):
+   g++ -O2 -std=c++17 -pthread -IConStorm/include Sandbox/bench/layout_bench.cpp \
+     $(find ConStorm/src -name '*.cpp' ! -path '*files*') -o layout_bench
+*/
+#include <cons/output.hpp>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr unsigned COLUMNS = 160;
+	constexpr unsigned ROWS = 200;
+
+	/**
+	 Builds the dashboard, adding the id of each text widget to `texts`
+	*/
+	cons::Layout make_dashboard(std::vector<cons::Layout::node_id>& texts)
+	{
+		cons::Layout layout;
+		layout.add_header(cons::Layout::ROOT, cons::Header("Dashboard"));
+		const auto row = layout.add_box(cons::Layout::ROOT, cons::Layout::direction::row);
+		for (int c = 0; c < 2; ++c)
+		{
+			const auto column = layout.add_box(row, cons::Layout::direction::column);
+			layout.set_border(column, true);
+			layout.set_padding(column, { 0, 1, 0, 1 });
+			for (int i = 0; i < 40; ++i)
+			{
+				texts.push_back(layout.add_text(column, cons::StyledText("Widget "
+					+ std::to_string(c * 40 + i)
+					+ ": the quick brown fox jumps over the lazy dog and keeps running")));
+			}
+		}
+		return layout;
+	}
+
+	template <class FuncTy>
+	double time_per_call(const int calls, FuncTy&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < calls; ++i)
+			func(i);
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		return std::chrono::duration<double, std::micro>(elapsed).count() / calls;
+	}
+} // namespace
+
+int main()
+{
+	std::vector<cons::Layout::node_id> texts;
+	auto layout = make_dashboard(texts);
+	layout.update(COLUMNS, ROWS);
+
+	const auto full_measures = layout.get_measure_count();
+	const auto full_arranges = layout.get_arrange_count();
+	layout.set_text(texts[7], cons::StyledText("Widget 7: changed text which wraps to "
+		"a different number of lines than before, much longer than the others"));
+	layout.update(COLUMNS, ROWS);
+
+	std::printf("%zu nodes\n", layout.size());
+	std::printf("%-22s %10s %10s\n", "passes", "measures", "arranges");
+	std::printf("%-22s %10zu %10zu\n", "full layout", full_measures, full_arranges);
+	std::printf("%-22s %10zu %10zu\n\n", "one widget changed",
+		layout.get_measure_count() - full_measures, layout.get_arrange_count() - full_arranges);
+
+	constexpr int UPDATES = 20000;
+	const auto relayout = time_per_call(UPDATES, [&](const int i)
+	{
+		layout.set_text(texts[7], cons::StyledText((i & 1) ? "Widget 7: short"
+			: "Widget 7: a somewhat longer line of text which wraps to two lines in this column"));
+		layout.update(COLUMNS, ROWS);
+	});
+
+	constexpr int FULL_LAYOUTS = 2000;
+	double full = 0;
+	for (int i = 0; i < FULL_LAYOUTS; ++i)
+	{ // Only the update is timed, not building the tree
+		std::vector<cons::Layout::node_id> fresh_texts;
+		auto fresh = make_dashboard(fresh_texts);
+		full += time_per_call(1, [&](int) { fresh.update(COLUMNS, ROWS); });
+	}
+
+	const auto clean = time_per_call(UPDATES, [&](int) { layout.update(COLUMNS, ROWS); });
+
+	std::printf("one-widget relayout: %8.2f us\n", relayout);
+	std::printf("full layout:         %8.2f us\n", full / FULL_LAYOUTS);
+	std::printf("unchanged update:    %8.3f us\n", clean);
+}
@@ -0,0 +1,156 @@
+/*
+ Code by Drake Johnson
+
+ Compares one buffered 'cons::print()' call with the per-line std::cout
+ writes print() made before it was buffered, for menus of 10, 100, and
+ 10,000 lines. Reports the system calls made, the bytes handed to each,
+ and the wall time per menu.
+
+ The old path is measured through a std::cout buffer that writes at every
+ newline, as stdio does for a terminal. Standard output is pointed at
+ /dev/null, so the times include the system calls but no terminal. The
+ system calls are counted by the kernel (/proc/self/io), so the counts
+ are only reported on Linux; the results go to standard error.
+
+ Build (from the repository root):
+   g++ -O2 -std=c++17 -pthread -IConStorm/include Sandbox/bench/print_bench.cpp \
+     $(find ConStorm/src -name '*.cpp' ! -path '*files*') -o print_bench
+*/
+#include <cons/output.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+	/**
+	 The write system calls and bytes written by this process so far, or
+	 zeros where /proc/self/io does not exist
+	*/
+	struct io_counters
+	{
+		size_t writes = 0;
+		size_t bytes = 0;
+
+		static io_counters read()
+		{
+			io_counters counters;
+			std::ifstream io("/proc/self/io");
+			std::string name;
+			size_t value = 0;
+			while (io >> name >> value)
+			{
+				if (name == "syscw:")
+					counters.writes = value;
+				else if (name == "wchar:")
+					counters.bytes = value;
+			}
+			return counters;
+		}
+	};
+
+	/**
+	 A std::cout buffer which writes each line with its own system call,
+	 as line-buffered stdio does for a terminal
+	*/
+	class line_buffer final : public std::streambuf
+	{
+	protected:
+		int_type overflow(const int_type ch) override
+		{
+			if (traits_type::eq_int_type(ch, traits_type::eof()))
+				return traits_type::not_eof(ch);
+
+			line_.push_back(traits_type::to_char_type(ch));
+			if (ch == '\n')
+				sync();
+			return ch;
+		}
+
+		int sync() override
+		{
+			if (!line_.empty())
+			{
+				if (::write(STDOUT_FILENO, line_.data(), line_.size()) < 0)
+					return -1;
+				line_.clear();
+			}
+			return 0;
+		}
+
+	private:
+		std::string line_;
+	};
+
+	/**
+	 The body of print() before it was buffered
+	*/
+	void print_per_line(const std::vector<std::string>& lines)
+	{
+		for (const auto& line : lines)
+			std::cout << line << '\n';
+		std::cout << std::flush;
+	}
+
+	struct result
+	{
+		double writes_per_menu;
+		double bytes_per_write;
+		double us_per_menu;
+	};
+
+	template <class FuncTy>
+	result measure(const int calls, FuncTy&& func)
+	{
+		const auto before = io_counters::read();
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < calls; ++i)
+			func();
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		const auto after = io_counters::read();
+
+		const auto writes = static_cast<double>(after.writes - before.writes);
+		return { writes / calls,
+			writes > 0 ? static_cast<double>(after.bytes - before.bytes) / writes : 0.0,
+			std::chrono::duration<double, std::micro>(elapsed).count() / calls };
+	}
+
+	void report(const size_t lines, const char* path, const result& r)
+	{
+		std::fprintf(stderr, "%8zu  %-10s %10.0f %12.1f %12.2f\n", lines, path,
+			r.writes_per_menu, r.bytes_per_write, r.us_per_menu);
+	}
+} // namespace
+
+int main()
+{
+	const int null_device = open("/dev/null", O_WRONLY);
+	if (null_device < 0 || dup2(null_device, STDOUT_FILENO) < 0)
+		return 1;
+	close(null_device);
+
+	std::fprintf(stderr, "%8s  %-10s %10s %12s %12s\n", "lines", "path", "syscalls",
+		"bytes/call", "us/menu");
+	for (const size_t count : { 10U, 100U, 10000U })
+	{
+		std::vector<std::string> lines;
+		for (size_t i = 0; i < count; ++i)
+			lines.push_back(" (" + std::to_string(i + 1) + ") Option number " + std::to_string(i + 1));
+		const int calls = count >= 10000 ? 50 : 5000;
+
+		line_buffer old_buf;
+		auto* const prev_buf = std::cout.rdbuf(&old_buf);
+		const auto old_result = measure(calls, [&] { print_per_line(lines); });
+		std::cout.rdbuf(prev_buf);
+
+		const auto new_result = measure(calls, [&] { cons::print(lines); });
+
+		report(count, "per-line", old_result);
+		report(count, "buffered", new_result);
+	}
+}
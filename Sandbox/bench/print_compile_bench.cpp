@@ -0,0 +1,125 @@
+/*
+ Code by Drake Johnson
+
+ Measures what the variadic print() costs the compiler: 200 print() calls,
+ each with 5-10 mixed arguments (literals, std::string, char, integers,
+ floats, bool, locals) and each with a different list of argument types.
+ Every block of ten calls ends with a string literal of a different length,
+ so no two calls, and no two argument suffixes, share an instantiation.
+
+ Built as is, the calls go through cons::print(), which formats every
+ argument in one fold expression. Built with -DRECURSIVE_PRINT, they go
+ through a copy of the old print(), which recursed through print_lines
+ once per remaining argument. Compare the compile time, the .text size,
+ and the number of print_lines symbols of the two object files:
+
+   time g++ -O0 -std=c++17 -IConStorm/include -c \
+     Sandbox/bench/print_compile_bench.cpp -o fold.o
+   time g++ -O0 -std=c++17 -IConStorm/include -DRECURSIVE_PRINT -c \
+     Sandbox/bench/print_compile_bench.cpp -o recursive.o
+   size fold.o recursive.o
+   nm -C fold.o | grep -c 'print_lines<'
+   nm -C recursive.o | grep -c 'print_lines<'
+
+ Repeat with -O2. Linked, the program runs every call into a NullSink and
+ reports the time per print().
+
+ Build (from the repository root):
+   g++ -O2 -std=c++17 -pthread -IConStorm/include Sandbox/bench/print_compile_bench.cpp \
+     $(find ConStorm/src -name '*.cpp' ! -path '*files*') -o print_compile_bench
+*/
+#include <cons/output.hpp>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#ifdef RECURSIVE_PRINT
+namespace recursive
+{
+	inline void print_lines() {}
+
+	template <typename LnTy, typename... OtherLnTy>
+	void print_lines(const LnTy& line, const OtherLnTy&... others)
+	{
+		auto& buf = cons::out();
+		cons::format_to(buf, line);
+		buf.append('\n');
+
+		// Print `others` recursively
+		print_lines(others...);
+	}
+
+	template <typename LnTy, typename... OtherLnTy>
+	void print(const LnTy& line, const OtherLnTy&... others)
+	{
+		cons::OutputFrame frame;
+		print_lines(line, others...);
+	}
+} // namespace recursive
+#	define BENCH_PRINT recursive::print
+#else
+#	define BENCH_PRINT cons::print
+#endif // RECURSIVE_PRINT
+
+// Ten calls with different argument lists, each ending with `tag`
+#define PRINT_BLOCK(tag)                                                                \
+	BENCH_PRINT(1, 2.5, 'c', name, tag);                                                \
+	BENCH_PRINT(name, true, 3u, "label", 4.5f, tag);                                    \
+	BENCH_PRINT(count, ratio, flag, 'x', std::string("temp"), 7L, tag);                 \
+	BENCH_PRINT("a", "bc", count, name, 1.0, 'y', tag);                                 \
+	BENCH_PRINT(8ULL, flag, ratio, "def", name, 9, 'z', tag);                           \
+	BENCH_PRINT(name, name, count, 2.0f, false, "gh", 10L, 'w', tag);                   \
+	BENCH_PRINT('q', 11, ratio, "ijk", std::string("t"), true, 12u, 3.5, tag);          \
+	BENCH_PRINT(count, "lm", flag, 13LL, name, 'r', 4.5, 14u, "nop", tag);              \
+	BENCH_PRINT(ratio, ratio, 15, "q", name, 's', false, 16L, 5.5f, count, tag);        \
+	BENCH_PRINT("rstu", 17u, name, 't', 18, 6.5, true, "v", count, 19ULL, tag)
+
+namespace
+{
+	void print_all(const std::string& name, const int count, const double ratio, const bool flag)
+	{
+		PRINT_BLOCK("1");
+		PRINT_BLOCK("12");
+		PRINT_BLOCK("123");
+		PRINT_BLOCK("1234");
+		PRINT_BLOCK("12345");
+		PRINT_BLOCK("123456");
+		PRINT_BLOCK("1234567");
+		PRINT_BLOCK("12345678");
+		PRINT_BLOCK("123456789");
+		PRINT_BLOCK("1234567890");
+		PRINT_BLOCK("12345678901");
+		PRINT_BLOCK("123456789012");
+		PRINT_BLOCK("1234567890123");
+		PRINT_BLOCK("12345678901234");
+		PRINT_BLOCK("123456789012345");
+		PRINT_BLOCK("1234567890123456");
+		PRINT_BLOCK("12345678901234567");
+		PRINT_BLOCK("123456789012345678");
+		PRINT_BLOCK("1234567890123456789");
+		PRINT_BLOCK("12345678901234567890");
+	}
+} // namespace
+
+int main()
+{
+	cons::NullSink sink;
+	cons::set_output_sink(&sink);
+
+	constexpr int ROUNDS = 5000;
+	const std::string name = "ConStorm";
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < ROUNDS; ++i)
+		print_all(name, i, i * 0.25, (i & 1) != 0);
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+
+	cons::set_output_sink(nullptr);
+	std::printf("%s print(): %.1f ns per call, %zu bytes\n",
+#ifdef RECURSIVE_PRINT
+		"recursive",
+#else
+		"fold",
+#endif // RECURSIVE_PRINT
+		std::chrono::duration<double, std::nano>(elapsed).count() / (ROUNDS * 200.0),
+		sink.get_bytes());
+}
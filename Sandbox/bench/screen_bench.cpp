@@ -0,0 +1,101 @@
+/*
+ Code by Drake Johnson
+
+ Measures the bytes a Menu redraw writes through the Screen, which sends
+ only the cells that changed, against clearing the screen and drawing the
+ whole menu (what every redraw did before). Runs headless on the memory
+ backend, so the results do not depend on the terminal.
+
+ Reported for an unchanged menu, a change to one option, a switch to a
+ different menu, and a redraw after output was sent to another sink
+ (which must not force a repaint).
+
+ Build (from the repository root):
+   g++ -O2 -std=c++17 -pthread -DCONS_BACKEND_MEMORY -IConStorm/include \
+     Sandbox/bench/screen_bench.cpp \
+     $(find ConStorm/src -name '*.cpp' ! -path '*files*') -o screen_bench
+*/
+#include <cons/output.hpp>
+#include <cons/menus.hpp>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+	/**
+	 Exposes the menu's redraw without waiting for input
+	*/
+	class bench_menu final : public cons::Menu
+	{
+	public:
+		using Menu::Menu;
+
+		void redraw() const { display(); }
+	};
+
+	/**
+	 @returns The bytes one redraw of `menu` writes, after a full repaint
+	          when `repaint` is set
+	*/
+	size_t redraw(const bench_menu& menu, const bool repaint)
+	{
+		if (repaint)
+			cons::Screen::get().invalidate();
+
+		auto& sink = cons::backend::memory::get_memory_sink();
+		sink.clear();
+		menu.redraw();
+		return sink.size();
+	}
+} // namespace
+
+int main()
+{
+	bench_menu main_menu(cons::Header("Main Menu"));
+	main_menu.set_description("This is the main menu. Below, select the number "
+		"that corresponds with your preferred option.", 60);
+	for (int i = 0; i < 8; ++i)
+		main_menu.append_option("Option number " + std::to_string(i + 1), nullptr);
+	main_menu.set_prompt_msg("Choice: ");
+
+	bench_menu other_menu(cons::Header("Settings"));
+	other_menu.set_description("A different menu with different text in every "
+		"row, so that nearly every cell changes.", 60);
+	for (int i = 0; i < 8; ++i)
+		other_menu.append_option("Setting " + std::string(i + 3, '*'), nullptr);
+
+	std::printf("%-22s %12s %12s\n", "redraw", "full (bytes)", "diff (bytes)");
+	size_t bytes[2][4] = {};
+	for (const bool repaint : { true, false })
+	{
+		auto* const row = bytes[repaint ? 0 : 1];
+		main_menu[3].text = "Option number 4";
+		redraw(main_menu, true);
+
+		row[0] = redraw(main_menu, repaint);
+		main_menu[3].text = "Option number 4 (selected)";
+		row[1] = redraw(main_menu, repaint);
+		row[2] = redraw(other_menu, repaint);
+
+		cons::MemorySink elsewhere;
+		cons::print_to(elsewhere, "Written to another sink");
+		row[3] = redraw(other_menu, repaint);
+	}
+
+	const char* const names[] = { "unchanged", "one option changed", "different menu",
+		"after print_to()" };
+	for (size_t i = 0; i < 4; ++i)
+		std::printf("%-22s %12zu %12zu\n", names[i], bytes[0][i], bytes[1][i]);
+
+	constexpr int REDRAWS = 20000;
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < REDRAWS; ++i)
+	{
+		main_menu[3].text = (i & 1) ? "Option number 4" : "Option number 4 (selected)";
+		redraw(main_menu, false);
+	}
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	std::printf("\none option changed: %.2f us per redraw\n",
+		std::chrono::duration<double, std::micro>(elapsed).count() / REDRAWS);
+}